@@ -0,0 +1,258 @@
+#include "Advisor.h"
+#include <algorithm>
+
+bool Advisor::Key::operator==(const Key &other) const
+{
+    return bytes == other.bytes;
+}
+
+std::size_t Advisor::KeyHash::operator()(const Key &key) const
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::uint8_t byte : key.bytes)
+        hash = (hash ^ byte) * 1099511628211ull;
+    return static_cast<std::size_t>(hash);
+}
+
+/**
+ * @param numDecks Number of decks in the shoe being tracked (1 to 15).
+ * @param budget Maximum time advise() may spend before falling back to basic strategy.
+ */
+Advisor::Advisor(int numDecks, std::chrono::microseconds budget)
+    : numDecks(std::min(std::max(numDecks, 1), 15)), budget(budget), fallback(Strategy::basic())
+{
+    draws.resize(std::size_t{1} << DrawBits);
+    reset();
+}
+
+/**
+ * @brief Starts tracking a freshly shuffled shoe.
+ *
+ * Cached dealer distributions are kept: they are keyed by the cards removed
+ * from a full shoe, which is the same for every shoe.
+ */
+void Advisor::reset()
+{
+    for (int v = 1; v <= 10; ++v)
+        counts[v - 1] = (v == 10 ? 16 : 4) * numDecks;
+    remaining = 52 * numDecks;
+    removed.bytes.fill(0);
+}
+
+/**
+ * @brief Removes a card that has become visible from the unseen composition.
+ *
+ * @param card The card that left the shoe face up.
+ */
+void Advisor::observe(const Card &card)
+{
+    int v = upcardValue(card);
+    if (counts[v - 1] > 0)
+    {
+        --counts[v - 1];
+        --remaining;
+        ++removed.bytes[v - 1];
+    }
+}
+
+/**
+ * @brief Checks the deadline, reading the clock only every few hundred steps.
+ */
+bool Advisor::outOfTime()
+{
+    if (!expired && (++steps & 0xFF) == 0)
+        expired = std::chrono::steady_clock::now() > deadline;
+    return expired;
+}
+
+/**
+ * @brief Finds the memo slot of a drawn multiset: its entry, or the empty slot to fill.
+ *
+ * @return DrawSlot* The slot, or nullptr if the table is too full to probe further.
+ */
+Advisor::DrawSlot *Advisor::findDraws(std::uint64_t drawn)
+{
+    const std::size_t mask = draws.size() - 1;
+    std::size_t index = static_cast<std::size_t>((drawn * 0x9E3779B97F4A7C15ull) >> (64 - DrawBits));
+    for (int probe = 0; probe < 32; ++probe, index = (index + 1) & mask)
+    {
+        DrawSlot &slot = draws[index];
+        if (slot.generation != generation || slot.drawn == drawn)
+            return &slot;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Distribution of the dealer's final total from a partial dealer hand.
+ *
+ * The dealer's state and the cards left both depend only on which cards were
+ * drawn, not on their order, so results are memoized per drawn multiset
+ * (4 bits per card value in @p drawn).
+ */
+Advisor::Distribution Advisor::dealerFrom(int total, bool soft, std::uint64_t drawn)
+{
+    Distribution dist{};
+    if (total > 21 && soft)
+    {
+        total -= 10;
+        soft = false;
+    }
+    if (total > 21)
+    {
+        dist[DealerBust] = 1.0;
+        return dist;
+    }
+    if (total >= 17)
+    {
+        dist[Dealer17 + (total - 17)] = 1.0;
+        return dist;
+    }
+
+    DrawSlot *slot = findDraws(drawn);
+    if (slot && slot->generation == generation)
+        return slot->dist;
+    if (remaining == 0 || outOfTime())
+        return dist;
+
+    for (int v = 1; v <= 10; ++v)
+    {
+        int n = counts[v - 1];
+        if (n == 0)
+            continue;
+        double p = static_cast<double>(n) / remaining;
+        --counts[v - 1];
+        --remaining;
+        std::uint64_t next = drawn + (std::uint64_t{1} << (4 * (v - 1)));
+        Distribution sub = v == 1 && total + 11 <= 21 ? dealerFrom(total + 11, true, next)
+                                                      : dealerFrom(total + v, soft, next);
+        ++counts[v - 1];
+        ++remaining;
+        for (int d = 0; d < DealerOutcomes; ++d)
+            dist[d] += p * sub[d];
+    }
+    // The recursion may have filled the slot's neighbourhood; look it up again
+    slot = findDraws(drawn);
+    if (slot)
+        *slot = DrawSlot{drawn, generation, dist};
+    return dist;
+}
+
+/**
+ * @brief Distribution of the dealer's final total for an upcard at the current composition.
+ *
+ * The hole card is unknown to the player, so it is drawn from the unseen cards
+ * like every later dealer card.
+ *
+ * @return const Distribution* The cached distribution, or nullptr if the deadline expired.
+ */
+const Advisor::Distribution *Advisor::dealerDistribution(int upcard)
+{
+    Key key = removed;
+    key.bytes[10] = static_cast<std::uint8_t>(upcard);
+    auto it = cache.find(key);
+    if (it != cache.end())
+        return &it->second;
+
+    if (++generation == 0)
+    {
+        // Generation counter wrapped: stale slots could look current, so wipe them
+        for (DrawSlot &slot : draws)
+            slot.generation = 0;
+        generation = 1;
+    }
+    Distribution dist = upcard == 1 ? dealerFrom(11, true, 0) : dealerFrom(upcard, false, 0);
+    if (expired)
+        return nullptr;
+    if (cache.size() >= MaxCached)
+        cache.clear();
+    return &cache.emplace(key, dist).first->second;
+}
+
+/**
+ * @brief Expected value of standing on @p total against a dealer distribution.
+ */
+double Advisor::standEv(int total, const Distribution &dealer) const
+{
+    if (total > 21)
+        return -1.0;
+    double ev = dealer[DealerBust];
+    for (int d = 17; d <= 21; ++d)
+    {
+        double p = dealer[Dealer17 + (d - 17)];
+        if (total > d)
+            ev += p;
+        else if (total < d)
+            ev -= p;
+    }
+    return ev;
+}
+
+/**
+ * @brief Recommends hit or stand for a hand against the dealer's upcard.
+ *
+ * Standing uses the exact dealer distribution for the unseen cards. Hitting
+ * plays on optimally, drawing from the same composition. Hit EVs are cheap to
+ * rebuild; only the dealer distribution is cached.
+ *
+ * @param hand The player's current hand (its cards must already be observed).
+ * @param upcard The dealer's visible card.
+ * @return Advice The best action and the EV of both options.
+ */
+Advice Advisor::advise(const Hand &hand, const Card &upcard)
+{
+    Advice basic{fallback.decide(hand, upcard), 0.0, 0.0, false};
+    if (remaining == 0 || hand.value() > 21)
+        return basic;
+
+    deadline = std::chrono::steady_clock::now() + budget;
+    steps = 0;
+    expired = false;
+
+    const Distribution *cached = dealerDistribution(upcardValue(upcard));
+    if (!cached)
+        return basic;
+    const Distribution &dealer = *cached;
+
+    // best[t][s]: EV of playing on optimally from hard (s = 0) or soft (s = 1) total t.
+    // Every state only depends on states filled before it: hard 21..11 draw to higher
+    // hard totals, soft 21..12 to higher soft or hard 12 and up, hard 10..4 to anything higher.
+    std::array<std::array<double, 2>, 22> best{};
+    std::array<std::array<double, 2>, 22> hit{};
+    const std::array<std::array<int, 3>, 3> passes = {{{21, 11, 0}, {21, 12, 1}, {10, 4, 0}}};
+    for (const auto &pass : passes)
+    {
+        int s = pass[2];
+        for (int t = pass[0]; t >= pass[1]; --t)
+        {
+            double ev = 0.0;
+            for (int v = 1; v <= 10; ++v)
+            {
+                double p = static_cast<double>(counts[v - 1]) / remaining;
+                int next = t + v;
+                bool soft = s == 1;
+                if (v == 1 && !soft && next + 10 <= 21)
+                {
+                    next += 10;
+                    soft = true;
+                }
+                if (next > 21 && soft)
+                {
+                    next -= 10;
+                    soft = false;
+                }
+                ev += p * (next > 21 ? -1.0 : best[next][soft ? 1 : 0]);
+            }
+            hit[t][s] = ev;
+            best[t][s] = std::max(ev, standEv(t, dealer));
+        }
+        if (outOfTime())
+            return basic;
+    }
+
+    int total = hand.value();
+    bool soft = hand.isSoft();
+    double standValue = standEv(total, dealer);
+    double hitValue = total >= 4 ? hit[total][soft ? 1 : 0] : -1.0;
+    return {hitValue > standValue ? Action::Hit : Action::Stand, hitValue, standValue, true};
+}
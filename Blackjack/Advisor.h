@@ -0,0 +1,112 @@
+#ifndef ADVISOR_H
+#define ADVISOR_H
+
+#include "Hand.h"
+#include "Strategy.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct Advice
+ * @brief Recommended action with the expected value of each option, in bet units.
+ *
+ * When the analysis could not finish within the time budget, the action comes
+ * from basic strategy and `exact` is false (the EVs are then meaningless).
+ */
+struct Advice
+{
+    Action action;
+    double hitEv;
+    double standEv;
+    bool exact;
+};
+
+/**
+ * @class Advisor
+ * @brief Real-time, composition-dependent hit/stand advice for the current shoe.
+ *
+ * The advisor tracks the unseen cards of the shoe as a delta from a full shoe:
+ * observe() removes each card as it becomes visible, in O(1). The expensive
+ * part of the analysis, the dealer's exact final-total distribution for an
+ * upcard, is cached under that delta, so it survives later shoes: the same
+ * cards seen against the same upcard are never analysed twice. A cache miss
+ * enumerates the dealer's draws as multisets rather than sequences, which
+ * keeps even a cold analysis well under the deadline. Player hit EVs are then
+ * derived from the distribution with a bottom-up table.
+ *
+ * advise() must answer within its time budget: the deadline is checked while
+ * analysing, and basic strategy is returned if it is exceeded.
+ *
+ * @note Shoes of up to 15 decks are supported (at most 255 cards of a value).
+ */
+class Advisor
+{
+public:
+    explicit Advisor(int numDecks = 1, std::chrono::microseconds budget = std::chrono::microseconds(1000));
+
+    void reset();
+    void observe(const Card &card);
+    Advice advise(const Hand &hand, const Card &upcard);
+
+private:
+    enum DealerTotal
+    {
+        Dealer17,
+        Dealer18,
+        Dealer19,
+        Dealer20,
+        Dealer21,
+        DealerBust,
+        DealerOutcomes
+    };
+    using Distribution = std::array<double, DealerOutcomes>;
+
+    // Cards removed from a full shoe, per value, plus the upcard in the last byte
+    struct Key
+    {
+        std::array<std::uint8_t, 11> bytes;
+        bool operator==(const Key &other) const;
+    };
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const;
+    };
+
+    // Open-addressed memo of dealer states, reset in O(1) by bumping the generation
+    struct DrawSlot
+    {
+        std::uint64_t drawn = 0;
+        std::uint32_t generation = 0;
+        Distribution dist{};
+    };
+
+    static constexpr std::size_t MaxCached = 1 << 16;
+    static constexpr int DrawBits = 14;
+
+    int numDecks;
+    std::chrono::microseconds budget;
+    Strategy fallback;
+
+    std::array<int, 10> counts;
+    int remaining = 0;
+    Key removed;
+
+    std::unordered_map<Key, Distribution, KeyHash> cache;
+    std::vector<DrawSlot> draws;
+    std::uint32_t generation = 0;
+
+    std::chrono::steady_clock::time_point deadline;
+    unsigned long steps = 0;
+    bool expired = false;
+
+    bool outOfTime();
+    DrawSlot *findDraws(std::uint64_t drawn);
+    Distribution dealerFrom(int total, bool soft, std::uint64_t drawn);
+    const Distribution *dealerDistribution(int upcard);
+    double standEv(int total, const Distribution &dealer) const;
+};
+
+#endif
@@ -0,0 +1,207 @@
+#include "AllocStats.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+std::uint64_t AllocCounters::totalAllocations() const
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t n : allocations)
+        total += n;
+    return total;
+}
+
+std::uint64_t AllocCounters::totalBytes() const
+{
+    std::uint64_t total = 0;
+    for (std::uint64_t n : bytes)
+        total += n;
+    return total;
+}
+
+/**
+ * @brief Counts accumulated between @p since and this snapshot.
+ */
+AllocCounters AllocCounters::operator-(const AllocCounters &since) const
+{
+    AllocCounters delta;
+    for (int i = 0; i < static_cast<int>(AllocSite::Count); ++i)
+    {
+        delta.allocations[i] = allocations[i] - since.allocations[i];
+        delta.bytes[i] = bytes[i] - since.bytes[i];
+    }
+    delta.frees = frees - since.frees;
+    delta.cardCopies = cardCopies - since.cardCopies;
+    return delta;
+}
+
+AllocCounters &AllocCounters::operator+=(const AllocCounters &other)
+{
+    for (int i = 0; i < static_cast<int>(AllocSite::Count); ++i)
+    {
+        allocations[i] += other.allocations[i];
+        bytes[i] += other.bytes[i];
+    }
+    frees += other.frees;
+    cardCopies += other.cardCopies;
+    return *this;
+}
+
+const char *allocstats::siteName(AllocSite site)
+{
+    switch (site)
+    {
+    case AllocSite::Deck:
+        return "deck";
+    case AllocSite::Round:
+        return "round";
+    case AllocSite::Display:
+        return "display";
+    case AllocSite::Log:
+        return "log";
+    default:
+        return "other";
+    }
+}
+
+/**
+ * @brief Prints one line per site that allocated, then frees and card copies.
+ *
+ * @param out Stream receiving the report.
+ * @param counters Usually the difference of two snapshots.
+ */
+void allocstats::report(std::ostream &out, const AllocCounters &counters)
+{
+    out << "allocations: " << counters.totalAllocations() << " (" << counters.totalBytes() << " bytes)";
+    for (int i = 0; i < static_cast<int>(AllocSite::Count); ++i)
+    {
+        if (counters.allocations[i] > 0)
+            out << " | " << siteName(static_cast<AllocSite>(i)) << ": " << counters.allocations[i] << " ("
+                << counters.bytes[i] << " bytes)";
+    }
+    out << " | frees: " << counters.frees << " | card copies: " << counters.cardCopies << "\n";
+}
+
+#ifdef BJ_ALLOC_STATS
+
+namespace
+{
+    constexpr int SiteCount = static_cast<int>(AllocSite::Count);
+
+    std::atomic<std::uint64_t> allocationCount[SiteCount];
+    std::atomic<std::uint64_t> allocationBytes[SiteCount];
+    std::atomic<std::uint64_t> freeCount;
+    std::atomic<std::uint64_t> cardCopyCount;
+
+    thread_local AllocSite currentSite = AllocSite::Other;
+
+    void *allocate(std::size_t size)
+    {
+        int site = static_cast<int>(currentSite);
+        allocationCount[site].fetch_add(1, std::memory_order_relaxed);
+        allocationBytes[site].fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void release(void *pointer)
+    {
+        if (!pointer)
+            return;
+        freeCount.fetch_add(1, std::memory_order_relaxed);
+        std::free(pointer);
+    }
+}
+
+AllocScope::AllocScope(AllocSite site) : previous(currentSite)
+{
+    currentSite = site;
+}
+
+AllocScope::~AllocScope()
+{
+    currentSite = previous;
+}
+
+bool allocstats::enabled()
+{
+    return true;
+}
+
+AllocCounters allocstats::snapshot()
+{
+    AllocCounters counters;
+    for (int i = 0; i < SiteCount; ++i)
+    {
+        counters.allocations[i] = allocationCount[i].load(std::memory_order_relaxed);
+        counters.bytes[i] = allocationBytes[i].load(std::memory_order_relaxed);
+    }
+    counters.frees = freeCount.load(std::memory_order_relaxed);
+    counters.cardCopies = cardCopyCount.load(std::memory_order_relaxed);
+    return counters;
+}
+
+void allocstats::countCardCopy()
+{
+    cardCopyCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Replacements of the global allocation functions (over-aligned variants are not counted)
+void *operator new(std::size_t size)
+{
+    if (void *pointer = allocate(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    release(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    release(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    release(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    release(pointer);
+}
+
+#else
+
+bool allocstats::enabled()
+{
+    return false;
+}
+
+AllocCounters allocstats::snapshot()
+{
+    return AllocCounters();
+}
+
+void allocstats::countCardCopy()
+{
+}
+
+#endif
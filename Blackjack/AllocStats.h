@@ -0,0 +1,75 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @enum AllocSite
+ * @brief Call-site category that heap allocations are charged to.
+ */
+enum class AllocSite
+{
+    Other,
+    Deck,
+    Round,
+    Display,
+    Log,
+    Count
+};
+
+/**
+ * @struct AllocCounters
+ * @brief Snapshot of the allocation and copy counters.
+ *
+ * Counters only ever grow; subtract two snapshots to measure a region.
+ */
+struct AllocCounters
+{
+    std::uint64_t allocations[static_cast<int>(AllocSite::Count)] = {};
+    std::uint64_t bytes[static_cast<int>(AllocSite::Count)] = {};
+    std::uint64_t frees = 0;
+    std::uint64_t cardCopies = 0;
+
+    std::uint64_t totalAllocations() const;
+    std::uint64_t totalBytes() const;
+    AllocCounters operator-(const AllocCounters &since) const;
+    AllocCounters &operator+=(const AllocCounters &other);
+};
+
+/**
+ * @class AllocScope
+ * @brief Charges the current thread's allocations to a site until it goes out of scope.
+ *
+ * Scopes nest: the innermost one wins and the outer site is restored on exit.
+ * In builds without BJ_ALLOC_STATS this compiles to nothing.
+ */
+class AllocScope
+{
+public:
+#ifdef BJ_ALLOC_STATS
+    explicit AllocScope(AllocSite site);
+    ~AllocScope();
+#else
+    explicit AllocScope(AllocSite) {}
+#endif
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+#ifdef BJ_ALLOC_STATS
+private:
+    AllocSite previous;
+#endif
+};
+
+namespace allocstats
+{
+    bool enabled();
+    AllocCounters snapshot();
+    const char *siteName(AllocSite site);
+    void report(std::ostream &out, const AllocCounters &counters);
+    void countCardCopy();
+}
+
+#endif
@@ -76,3 +76,39 @@ std::string Card::getSuitSymbol() const
         return "?";
     }
 }
+
+/**
+ * @brief Packs the card into a single byte.
+ *
+ * The rank occupies the low four bits and the suit the next two, so every
+ * card fits in 6 bits. Used by the binary hand-history format.
+ *
+ * @return std::uint8_t The packed card.
+ */
+std::uint8_t Card::toByte() const
+{
+    return static_cast<std::uint8_t>(rank | (static_cast<int>(suit) << 4));
+}
+
+/**
+ * @brief Rebuilds a card from the byte produced by toByte().
+ *
+ * @param byte The packed card.
+ * @return Card The unpacked card.
+ */
+Card Card::fromByte(std::uint8_t byte)
+{
+    return Card(byte & 0x0F, static_cast<Suit>((byte >> 4) & 0x03));
+}
+
+/**
+ * @brief Checks that a byte is one toByte() can produce.
+ *
+ * @param byte The packed card.
+ * @return true if the rank is 1–13 and the top two bits are clear.
+ */
+bool Card::isValidByte(std::uint8_t byte)
+{
+    int r = byte & 0x0F;
+    return (byte & 0xC0) == 0 && r >= 1 && r <= 13;
+}
@@ -1,6 +1,10 @@
 #ifndef CARD_H
 #define CARD_H
 
+#ifdef BJ_ALLOC_STATS
+#include "AllocStats.h"
+#endif
+#include <cstdint>
 #include <string>
 
 enum class Suit
@@ -23,6 +27,18 @@ class Card
 public:
     Card(int r = 0, Suit s = Suit::Clubs);
 
+#ifdef BJ_ALLOC_STATS
+    // Instrumented builds count copies; without a move constructor, moves are counted too
+    Card(const Card &other) : rank(other.rank), suit(other.suit) { allocstats::countCardCopy(); }
+    Card &operator=(const Card &other)
+    {
+        rank = other.rank;
+        suit = other.suit;
+        allocstats::countCardCopy();
+        return *this;
+    }
+#endif
+
     int getRank() const;
     Suit getSuit() const;
     std::string toString() const;
@@ -30,6 +46,10 @@ public:
     std::string getDisplayValue() const;
     std::string getSuitSymbol() const;
 
+    std::uint8_t toByte() const;
+    static Card fromByte(std::uint8_t byte);
+    static bool isValidByte(std::uint8_t byte);
+
 private:
     int rank; // 1–13: A=1, J=11, Q=12, K=13
     Suit suit;
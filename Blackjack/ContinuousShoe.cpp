@@ -0,0 +1,119 @@
+#include "ContinuousShoe.h"
+#include <cassert>
+
+/**
+ * @brief Removes every card, keeping the node pool's capacity.
+ */
+void ContinuousShoe::clear()
+{
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+}
+
+std::size_t ContinuousShoe::size() const
+{
+    return sizeOf(root);
+}
+
+std::uint32_t ContinuousShoe::sizeOf(std::int32_t node) const
+{
+    return node < 0 ? 0 : nodes[node].size;
+}
+
+void ContinuousShoe::update(std::int32_t node)
+{
+    nodes[node].size = 1 + sizeOf(nodes[node].left) + sizeOf(nodes[node].right);
+}
+
+/**
+ * @brief Splits a subtree into its first @p count cards and the rest.
+ */
+void ContinuousShoe::split(std::int32_t node, std::size_t count, std::int32_t &first, std::int32_t &rest)
+{
+    if (node < 0)
+    {
+        first = rest = -1;
+        return;
+    }
+    if (sizeOf(nodes[node].left) >= count)
+    {
+        split(nodes[node].left, count, first, nodes[node].left);
+        rest = node;
+    }
+    else
+    {
+        split(nodes[node].right, count - sizeOf(nodes[node].left) - 1, nodes[node].right, rest);
+        first = node;
+    }
+    update(node);
+}
+
+/**
+ * @brief Concatenates two subtrees, @p first on top.
+ */
+std::int32_t ContinuousShoe::merge(std::int32_t first, std::int32_t second)
+{
+    if (first < 0)
+        return second;
+    if (second < 0)
+        return first;
+    if (nodes[first].priority > nodes[second].priority)
+    {
+        nodes[first].right = merge(nodes[first].right, second);
+        update(first);
+        return first;
+    }
+    nodes[second].left = merge(first, nodes[second].left);
+    update(second);
+    return second;
+}
+
+/**
+ * @brief Puts a card back at a uniformly random position (top and bottom included).
+ *
+ * @param card The discarded card.
+ * @param rng Source of the position and of the node's heap priority.
+ */
+void ContinuousShoe::insert(const Card &card, std::mt19937 &rng)
+{
+    std::int32_t node;
+    if (freeNodes.empty())
+    {
+        node = static_cast<std::int32_t>(nodes.size());
+        nodes.push_back(Node{card, 0, -1, -1, 1});
+        // Every node can be dealt at once, so size the free list now rather than mid-round
+        if (freeNodes.capacity() < nodes.size())
+            freeNodes.reserve(nodes.capacity());
+    }
+    else
+    {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[node] = Node{card, 0, -1, -1, 1};
+    }
+    nodes[node].priority = static_cast<std::uint32_t>(rng());
+
+    std::uniform_int_distribution<std::size_t> position(0, size());
+    std::int32_t first, rest;
+    split(root, position(rng), first, rest);
+    root = merge(merge(first, node), rest);
+}
+
+/**
+ * @brief Removes and returns the top card.
+ *
+ * The shoe must not be empty. Release builds return a default Card (rank 0)
+ * instead of touching the node pool.
+ */
+Card ContinuousShoe::deal()
+{
+    assert(root >= 0 && "deal() from an empty continuous shoe");
+    if (root < 0)
+        return Card();
+    std::int32_t top, rest;
+    split(root, 1, top, rest);
+    root = rest;
+    freeNodes.push_back(top);
+    return nodes[top].card;
+}
@@ -0,0 +1,49 @@
+#ifndef CONTINUOUS_SHOE_H
+#define CONTINUOUS_SHOE_H
+
+#include "Card.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @class ContinuousShoe
+ * @brief Card order of a continuous shuffling machine, kept in an implicit treap.
+ *
+ * Cards are dealt from the top and discards are reinserted at uniformly random
+ * positions, each in O(log n) expected time instead of a reshuffle. Filling an
+ * empty shoe by random insertions yields a uniformly shuffled shoe.
+ *
+ * Nodes live in a single pool indexed by position, and freed nodes are reused,
+ * so a shoe that is dealt and refilled every round stops allocating.
+ */
+class ContinuousShoe
+{
+public:
+    void clear();
+    void insert(const Card &card, std::mt19937 &rng);
+    Card deal();
+    std::size_t size() const;
+
+private:
+    struct Node
+    {
+        Card card;
+        std::uint32_t priority;
+        std::int32_t left;
+        std::int32_t right;
+        std::uint32_t size;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::int32_t> freeNodes;
+    std::int32_t root = -1;
+
+    std::uint32_t sizeOf(std::int32_t node) const;
+    void update(std::int32_t node);
+    void split(std::int32_t node, std::size_t count, std::int32_t &first, std::int32_t &rest);
+    std::int32_t merge(std::int32_t first, std::int32_t second);
+};
+
+#endif
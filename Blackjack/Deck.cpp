@@ -1,22 +1,54 @@
 #include "Deck.h"
+#include "AllocStats.h"
 
 /**
  * @brief Constructs a standard deck of 52 playing cards and shuffles it.
  *
  * Initializes the deck by creating 52 cards, one for each combination of rank (1 to 13)
  * and suit (0 to 3, cast to Suit enum). The deck is then shuffled using a random number generator.
+ *
+ * @param numDecks Number of 52-card packs in the shoe (1 for a single deck).
+ */
+Deck::Deck(int numDecks) : rng(std::random_device{}()), numDecks(numDecks)
+{
+    cards.reserve(52 * numDecks);
+    reset();
+}
+
+/**
+ * @brief Puts all cards back into the deck and shuffles it.
+ *
+ * Refills the existing storage in place, so a deck reused across rounds keeps
+ * its capacity and its random number generator instead of being rebuilt.
+ * In lazy mode the up-front shuffle is skipped; deal() randomizes instead.
+ * In continuous mode the shuffling machine is reloaded with every card.
  */
-Deck::Deck() : rng(std::random_device{}())
+void Deck::reset()
 {
-    cards.reserve(52);
-    for (int s = 0; s < 4; ++s)
+    AllocScope scope(AllocSite::Deck);
+    external = nullptr;
+    if (continuous)
     {
-        for (int r = 1; r <= 13; ++r)
+        machine.clear();
+        for (int d = 0; d < numDecks; ++d)
+            for (int s = 0; s < 4; ++s)
+                for (int r = 1; r <= 13; ++r)
+                    machine.insert(Card(r, static_cast<Suit>(s)), rng);
+        return;
+    }
+    cards.clear();
+    for (int d = 0; d < numDecks; ++d)
+    {
+        for (int s = 0; s < 4; ++s)
         {
-            cards.emplace_back(r, static_cast<Suit>(s));
+            for (int r = 1; r <= 13; ++r)
+            {
+                cards.emplace_back(r, static_cast<Suit>(s));
+            }
         }
     }
-    shuffle();
+    if (!lazyShuffle)
+        shuffle();
 }
 
 /**
@@ -30,15 +62,115 @@ void Deck::shuffle()
     std::shuffle(cards.begin(), cards.end(), rng);
 }
 
+/**
+ * @brief Reseeds the random number generator, making later shuffles reproducible.
+ *
+ * @param value The new seed.
+ */
+void Deck::seed(std::uint32_t value)
+{
+    rng.seed(value);
+}
+
+/**
+ * @brief Replaces the deck's content with a predetermined card order.
+ *
+ * The cards are given as Card::toByte() bytes and are dealt from the end of the
+ * sequence, matching how deal() takes cards from the back of the deck. Used to
+ * replay the same shoes across runs, e.g. for common random numbers.
+ *
+ * @param order Packed cards, last one dealt first.
+ * @param count Number of cards in @p order.
+ */
+void Deck::assign(const std::uint8_t *order, std::size_t count)
+{
+    external = nullptr;
+    cards.clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        cards.push_back(Card::fromByte(order[i]));
+    }
+}
+
+/**
+ * @brief Swaps the deck's cards with a prepared shoe in constant time.
+ *
+ * The cards are dealt as given, from the back. Used with ShoeQueue to take
+ * shoes shuffled in the background; @p shoe receives the old cards.
+ *
+ * @param shoe The shoe to deal from next.
+ */
+void Deck::exchange(std::vector<Card> &shoe)
+{
+    external = nullptr;
+    cards.swap(shoe);
+}
+
+/**
+ * @brief Deals directly from packed card bytes, without copying them.
+ *
+ * Like assign(), the last byte is dealt first, but the bytes are only
+ * referenced: they must stay valid until the deck is reset or reassigned.
+ * Lazy shuffling does not apply to an attached order.
+ *
+ * @param order Packed cards (Card::toByte()), last one dealt first.
+ * @param count Number of cards in @p order.
+ */
+void Deck::attach(const std::uint8_t *order, std::size_t count)
+{
+    external = order;
+    externalCount = count;
+}
+
+/**
+ * @brief Enables or disables lazy (incremental) shuffling.
+ *
+ * @param lazy If true, reset() no longer shuffles and every deal() draws a
+ *             uniformly random card from the remaining ones instead.
+ */
+void Deck::setLazyShuffle(bool lazy)
+{
+    lazyShuffle = lazy;
+}
+
+/**
+ * @brief Mirrors the random picks of lazy dealing.
+ *
+ * With the same seed, a mirrored deck picks remaining card m-1-j wherever the
+ * normal deck picks card j. This gives the antithetic counterpart of a shuffle
+ * for variance reduction. It has no effect unless lazy shuffling is enabled.
+ *
+ * @param mirrored True to mirror every pick.
+ */
+void Deck::setAntithetic(bool mirrored)
+{
+    antithetic = mirrored;
+}
+
 /**
  * @brief Deals a card from the deck.
  *
  * Removes and returns the card from the top of the deck (the back of the cards vector).
+ * In lazy mode a random remaining card is first swapped to the top. This is one step
+ * of a back-to-front Fisher–Yates shuffle, so the sequence of dealt cards has exactly
+ * the distribution of dealing from a fully shuffled deck.
  *
  * @return Card The card dealt from the deck.
  */
 Card Deck::deal()
 {
+    if (external)
+        return Card::fromByte(external[--externalCount]);
+    if (continuous)
+        return machine.deal();
+    if (lazyShuffle)
+    {
+        std::uniform_int_distribution<std::size_t> pick(0, cards.size() - 1);
+        std::size_t j = pick(rng);
+        if (antithetic)
+            j = cards.size() - 1 - j;
+        std::swap(cards[j], cards.back());
+    }
     Card c = cards.back();
     cards.pop_back();
     return c;
@@ -51,5 +183,49 @@ Card Deck::deal()
  */
 bool Deck::empty() const
 {
-    return cards.empty();
+    return size() == 0;
+}
+
+std::size_t Deck::size() const
+{
+    if (external)
+        return externalCount;
+    return continuous ? machine.size() : cards.size();
+}
+
+/**
+ * @brief Switches the deck to (or from) a continuous shuffling machine and refills it.
+ *
+ * In continuous mode a round should not reset() the deck: the cards it used are
+ * returned with discard() once it is settled, and the next round deals on.
+ *
+ * @param enabled true to model a continuous shuffling machine.
+ */
+void Deck::setContinuous(bool enabled)
+{
+    continuous = enabled;
+    reset();
+}
+
+bool Deck::isContinuous() const
+{
+    return continuous;
+}
+
+/**
+ * @brief Returns a used card to the shuffling machine at a random position.
+ *
+ * Costs O(log n). Has no effect unless the deck is in continuous mode.
+ *
+ * @param card The card leaving the table.
+ */
+void Deck::discard(const Card &card)
+{
+    if (continuous)
+        machine.insert(card, rng);
+}
+
+int Deck::getNumDecks() const
+{
+    return numDecks;
 }
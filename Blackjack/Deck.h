@@ -1,6 +1,8 @@
 #ifndef DECK_H
 #define DECK_H
 #include "Card.h"
+#include "ContinuousShoe.h"
+#include <cstdint>
 #include <vector>
 #include <algorithm>
 #include <random>
@@ -10,21 +12,47 @@
  * @brief Represents a standard deck of playing cards for use in games like Blackjack.
  *
  * The Deck class manages a collection of Card objects, providing functionality
- * to shuffle the deck, deal cards, and check if the deck is empty.
+ * to shuffle the deck, deal cards, and check if the deck is empty. A deck can also
+ * hold several 52-card packs (a shoe), be loaded with a predetermined order, or
+ * deal directly from packed card bytes owned elsewhere (e.g. a memory-mapped corpus).
  *
  * @note The deck uses a Mersenne Twister random number generator for shuffling.
+ *       In lazy mode the shuffle is spread over the deals: each deal() performs
+ *       a single Fisher–Yates step, so only the cards actually used are randomized.
+ *       In continuous mode the deck models a continuous shuffling machine: the
+ *       cards live in a ContinuousShoe, and discard() puts used cards back at
+ *       random positions instead of waiting for a reshuffle.
  */
 class Deck
 {
 public:
-    Deck();
+    explicit Deck(int numDecks = 1);
+    void reset();
     void shuffle();
+    void seed(std::uint32_t value);
+    void setLazyShuffle(bool lazy);
+    void setAntithetic(bool mirrored);
+    void setContinuous(bool enabled);
+    bool isContinuous() const;
+    void discard(const Card &card);
+    void assign(const std::uint8_t *order, std::size_t count);
+    void exchange(std::vector<Card> &shoe);
+    void attach(const std::uint8_t *order, std::size_t count);
     Card deal();
     bool empty() const;
+    std::size_t size() const;
+    int getNumDecks() const;
 
 private:
     std::vector<Card> cards;
     std::mt19937 rng;
+    int numDecks;
+    bool lazyShuffle = false;
+    bool antithetic = false;
+    bool continuous = false;
+    ContinuousShoe machine;
+    const std::uint8_t *external = nullptr;
+    std::size_t externalCount = 0;
 };
 
 #endif
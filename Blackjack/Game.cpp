@@ -1,11 +1,106 @@
 #include "Game.h"
+#include "Leaderboard.h"
 #include <iostream>
-#include <fstream>
 #include <ctime>
 #include <iomanip>
 #include <algorithm>
 
-Game::Game() : dealer("Dealer") {}
+/**
+ * @brief Creates a game reading its answers from @p input and rendering to @p out.
+ *
+ * @param input Source of menu choices, names, bets and hit/stand decisions.
+ * @param out Stream receiving everything the game displays.
+ * @param shoeQueueDepth Number of decks shuffled ahead on a background thread.
+ *                       0 keeps shuffling lazily while dealing instead.
+ */
+Game::Game(Input &input, std::ostream &out, std::size_t shoeQueueDepth)
+    : input(input), out(out), dealer("Dealer"), scores("scores.txt"), history("history.bjh")
+{
+    // history.bjh is appended across sessions, so continue its round numbering
+    roundId = HandHistoryReader("history.bjh").lastRoundId();
+    if (shoeQueueDepth > 0)
+    {
+        shoes = std::make_unique<ShoeQueue>(1, shoeQueueDepth);
+    }
+    else
+    {
+        // A round only uses a handful of cards, so randomize them as they are dealt.
+        deck.setLazyShuffle(true);
+    }
+}
+
+/**
+ * @brief Enables or disables the decision advisor.
+ *
+ * When enabled, every hit/stand prompt is preceded by the best action for the
+ * cards still unseen in the deck and the expected value of both options.
+ *
+ * @param enabled true to show advice, false to hide it.
+ */
+void Game::setAdvisor(bool enabled)
+{
+    if (enabled)
+        advisor = std::make_unique<Advisor>(deck.getNumDecks());
+    else
+        advisor.reset();
+}
+
+/**
+ * @brief Switches between a fresh deck per round and a continuous shuffling machine.
+ *
+ * With a machine, the deck is never reset between rounds: the cards of each settled
+ * round are put back at random positions, as a casino CSM does. A background shoe
+ * queue would have nothing to supply, so it is stopped.
+ *
+ * @param enabled true to deal from a continuous shuffling machine.
+ */
+void Game::setContinuousShuffle(bool enabled)
+{
+    if (enabled)
+        shoes.reset();
+    deck.setContinuous(enabled);
+}
+
+/**
+ * @brief Puts the cards of the round just settled back into the shuffling machine.
+ *
+ * Does nothing unless the game deals from a continuous shuffling machine.
+ */
+void Game::collectCards()
+{
+    if (!deck.isContinuous())
+        return;
+    for (const auto &player : players)
+        for (const Card &card : player.getHand())
+            deck.discard(card);
+    for (const Card &card : dealer.getHand())
+        deck.discard(card);
+}
+
+/**
+ * @brief Shows what the round just settled allocated and copied.
+ *
+ * Only instrumented builds (BJ_ALLOC_STATS) count anything, so this is silent otherwise.
+ * The round spans dealing, every decision and the settlement of every player.
+ */
+void Game::reportAllocations()
+{
+    if (!allocstats::enabled())
+        return;
+    out << "Round " << roundId << " ";
+    allocstats::report(out, allocstats::snapshot() - roundStart);
+}
+
+/**
+ * @brief Removes a face-up card from the advisor's view of the deck.
+ *
+ * @param card The card every player at the table can now see.
+ */
+void Game::reveal(const Card &card)
+{
+    if (advisor)
+        advisor->observe(card);
+}
 
 /**
  * @brief Starts and manages a single game of Blackjack.
@@ -25,24 +120,26 @@ void Game::playSingleGame()
 {
     players.clear();
     int numPlayers;
-    std::cout << "How many players? ";
-    std::cin >> numPlayers;
-    std::cin.ignore();
+    out << "How many players? ";
+    if (!input.readInt(numPlayers))
+        numPlayers = 0;
 
     for (int i = 0; i < numPlayers; ++i)
     {
         std::string name;
-        std::cout << "Player name " << (i + 1) << ": ";
-        std::getline(std::cin, name);
+        out << "Player name " << (i + 1) << ": ";
+        input.readLine(name);
         players.emplace_back(name);
     }
 
     playRound();
 
-    for (auto &player : players)
+    for (std::size_t seat = 0; seat < players.size(); ++seat)
     {
-        showResult(player);
+        showResult(players[seat], static_cast<int>(seat));
     }
+    collectCards();
+    reportAllocations();
 }
 
 /**
@@ -52,8 +149,8 @@ void Game::playSingleGame()
  * - Prompting the user for the number of players and their names.
  * - Asking for the number of rounds (manches) to play.
  * - Playing each round, updating player balances, and eliminating players with zero tokens.
- * - Displaying results after each round and removing eliminated players.
- * - Sorting and displaying the final ranking of players by their balances.
+ * - Displaying results and live standings after each round and removing eliminated players.
+ * - Displaying the final ranking of players by their balances.
  * - Announcing the winner with celebratory ASCII art and a congratulatory message.
  * - Displaying a random motivational or game-related quote at the end of the tournament.
  *
@@ -62,74 +159,94 @@ void Game::playSingleGame()
 void Game::playTournament()
 {
     players.clear();
-    // Clear previous scores at the start of the game
-    std::ofstream clearFile("scores.txt", std::ios::trunc);
+    // Clear previous scores (every segment and the summary) at the start of the game
+    scores.clear();
 
-    int numPlayers, nbManches;
-    std::cout << "How many players? ";
-    std::cin >> numPlayers;
-    std::cin.ignore();
+    int numPlayers, nbManches = 0;
+    out << "How many players? ";
+    if (!input.readInt(numPlayers))
+        numPlayers = 0;
 
     for (int i = 0; i < numPlayers; ++i)
     {
         std::string name;
-        std::cout << "Player name " << (i + 1) << ": ";
-        std::getline(std::cin, name);
+        out << "Player name " << (i + 1) << ": ";
+        input.readLine(name);
         players.emplace_back(name);
     }
 
-    std::cout << "Number of rounds : ";
-    std::cin >> nbManches;
+    out << "Number of rounds : ";
+    input.readInt(nbManches);
 
-    std::map<std::string, double> scores;
+    // Ranking kept up to date as each player is settled. Players are ranked by their
+    // registration number, so two players may share a name.
+    Leaderboard leaderboard;
+    std::vector<std::size_t> ids(players.size());
+    for (std::size_t id = 0; id < players.size(); ++id)
+    {
+        ids[id] = id;
+        leaderboard.update(id, players[id].getName(), players[id].getBalance());
+    }
 
     for (int manche = 1; manche <= nbManches; ++manche)
     {
-        std::cout << "\n===== Manche " << manche << " =====\n";
+        out << "\n===== Manche " << manche << " =====\n";
         playRound();
 
-        for (auto &player : players)
+        for (std::size_t seat = 0; seat < players.size(); ++seat)
         {
-            showResult(player, &scores);
+            showResult(players[seat], static_cast<int>(seat));
+            leaderboard.update(ids[seat], players[seat].getName(), players[seat].getBalance());
         }
+        collectCards();
+        reportAllocations();
         // Suppress players with zero balance
-        players.erase(
-            std::remove_if(players.begin(), players.end(),
-                           [](const Player &p)
-                           {
-                               if (p.getBalance() <= 0)
-                               {
-                                   std::cout << p.getName() << " was eliminated (out of tokens).\n";
-                                   return true;
-                               }
-                               return false;
-                           }),
-            players.end());
+        std::size_t kept = 0;
+        for (std::size_t seat = 0; seat < players.size(); ++seat)
+        {
+            if (players[seat].getBalance() <= 0)
+            {
+                out << players[seat].getName() << " was eliminated (out of tokens).\n";
+                leaderboard.remove(ids[seat]);
+                continue;
+            }
+            if (kept != seat)
+            {
+                players[kept] = std::move(players[seat]);
+                ids[kept] = ids[seat];
+            }
+            ++kept;
+        }
+        players.erase(players.begin() + static_cast<std::ptrdiff_t>(kept), players.end());
+        ids.resize(kept);
 
         // End of game if no players left
         if (players.empty())
         {
-            std::cout << "No players left. Tournament ends.\n";
+            out << "No players left. Tournament ends.\n";
             return;
         }
 
-        std::cout << "-------------------------------\n";
+        // Live standings
+        out << "Standings:\n";
+        std::size_t rank = 1;
+        for (const auto &entry : leaderboard.top(3))
+        {
+            out << "  " << rank++ << ". " << entry.name << " : " << entry.balance << " tokens\n";
+        }
+
+        out << "-------------------------------\n";
     }
 
-    // Display ranking
-    // Sort players by balance descending
-    std::sort(players.begin(), players.end(),
-              [](const Player &a, const Player &b)
-              {
-                  return a.getBalance() > b.getBalance();
-              });
+    // Display ranking, already ordered by balance descending
+    std::vector<LeaderboardEntry> ranking = leaderboard.top(leaderboard.size());
 
-    std::cout << "\n💰 FINAL RANKING BY BALANCE 💰\n";
-    if (!players.empty())
+    out << "\n💰 FINAL RANKING BY BALANCE 💰\n";
+    if (!ranking.empty())
     {
-        const auto &winner = players.front();
-        std::cout << "\n\n🎉🏆 CONGRATULATIONS, " << winner.getName() << "! 🏆🎉\n";
-        std::cout << R"(
+        const auto &winner = ranking.front();
+        out << "\n\n🎉🏆 CONGRATULATIONS, " << winner.name << "! 🏆🎉\n";
+        out << R"(
 
   ██████╗ ██╗   ██╗ █████╗ ███╗   ██╗██╗ ██████╗ ███████╗
  ██╔═══██╗██║   ██║██╔══██╗████╗  ██║██║██╔════╝ ██╔════╝
@@ -139,19 +256,19 @@ void Game::playTournament()
   ╚══▀▀═╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═══╝╚═╝ ╚═════╝ ╚══════╝
 
 )";
-        std::cout << "\n👑 " << winner.getName() << " has proven to be the true Blackjack Champion!";
-        std::cout << "\n💸 Final balance: " << winner.getBalance() << " tokens";
-        std::cout << "\n🥇 A master of strategy, risk and luck. Well played!\n\n";
-        std::cout << "\a"; // Terminal beep (bell character)
+        out << "\n👑 " << winner.name << " has proven to be the true Blackjack Champion!";
+        out << "\n💸 Final balance: " << winner.balance << " tokens";
+        out << "\n🥇 A master of strategy, risk and luck. Well played!\n\n";
+        out << "\a"; // Terminal beep (bell character)
     }
 
-    for (const auto &player : players)
+    for (const auto &entry : ranking)
     {
-        std::cout << std::setw(10) << player.getName()
-                  << " : " << player.getBalance() << " tokens\n";
+        out << std::setw(10) << entry.name
+            << " : " << entry.balance << " tokens\n";
     }
 
-    std::cout << R"(
+    out << R"(
   _______ _                 _   _                 _ 
  |__   __| |               | | (_)               | |
     | |  | |__   __ _ _ __ | |_ _  ___  _ __  ___| |
@@ -187,43 +304,67 @@ void Game::playTournament()
 
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
     int index = std::rand() % quotes.size();
-    std::cout << "\n📣 " << quotes[index] << "\n";
+    out << "\n📣 " << quotes[index] << "\n";
 }
 
 /**
  * @brief Plays a single round of Blackjack for all players and the dealer.
  *
  * This function resets the dealer and deck, shuffles the deck, and initializes each player
- * for the round. Each player is prompted to place a bet within their balance, and is dealt two cards.
+ * for the round. Players, dealer and deck are reset in place rather than rebuilt, so
+ * balances carry over between rounds and no storage is reallocated. With a shoe queue,
+ * the round starts on a deck that was already shuffled in the background. With a continuous
+ * shuffling machine the deck is not reset at all; it deals on after the last round's cards
+ * were returned to it.
+ * Each player is prompted to place a bet within their balance, and is dealt two cards.
  * The dealer is also dealt two cards. Then, each player takes their turn, followed by the dealer's turn.
  *
  * The function manages the flow of a complete round, including betting, dealing, and player/dealer actions.
  */
 void Game::playRound()
 {
-    dealer = Player("Dealer");
-    deck = Deck();
-    deck.shuffle();
+    roundStart = allocstats::snapshot();
+    AllocScope scope(AllocSite::Round);
+    ++roundId;
+    dealer.resetForRound();
+    // A continuous shuffling machine already holds the previous round's cards again
+    if (!deck.isContinuous())
+    {
+        if (shoes)
+            shoes->next(deck);
+        else
+            deck.reset();
+    }
+    if (advisor)
+        advisor->reset();
 
     for (auto &player : players)
     {
-        player = Player(player.getName());
+        player.resetForRound();
 
-        std::cout << player.getName() << ", current balance : " << player.getBalance() << " tokens.\n";
+        out << player.getName() << ", current balance : " << player.getBalance() << " tokens.\n";
         int mise = 0;
         do
         {
-            std::cout << "Enter your bet : ";
-            std::cin >> mise;
+            out << "Enter your bet : ";
+            if (!input.readInt(mise))
+            {
+                mise = 1;
+                break;
+            }
         } while (mise < 1 || mise > player.getBalance());
 
         player.setBet(mise);
         player.takeCard(deck.deal());
         player.takeCard(deck.deal());
+        reveal(player.getHand()[0]);
+        reveal(player.getHand()[1]);
     }
 
+    // The first dealer card is the hole card: it stays unseen until the dealer plays
     dealer.takeCard(deck.deal());
     dealer.takeCard(deck.deal());
+    reveal(dealer.getHand()[1]);
 
     for (auto &player : players)
     {
@@ -251,15 +392,27 @@ void Game::playerTurn(Player &player)
         showHands(player, false);
         if (player.isBusted())
         {
-            std::cout << player.getName() << " busted (over 21) !\n";
+            out << player.getName() << " busted (over 21) !\n";
             return;
         }
-        std::cout << "Hit ou stand (h/s) ? ";
-        char choice;
-        std::cin >> choice;
+        if (advisor)
+        {
+            Advice advice = advisor->advise(player.getHand(), dealer.getHand()[1]);
+            out << "Advisor: " << (advice.action == Action::Hit ? "hit" : "stand");
+            if (advice.exact)
+                out << std::showpos << std::fixed << std::setprecision(3) << " (EV hit " << advice.hitEv
+                    << ", stand " << advice.standEv << ")" << std::noshowpos << std::defaultfloat;
+            else
+                out << " (basic strategy)";
+            out << "\n";
+        }
+        out << "Hit ou stand (h/s) ? ";
+        char choice = 's';
+        input.readChar(choice);
         if (choice == 'h')
         {
             player.takeCard(deck.deal());
+            reveal(player.getHand()[player.getHand().size() - 1]);
         }
         else
         {
@@ -293,112 +446,96 @@ void Game::dealerTurn()
  */
 void Game::showHands(const Player &player, bool showDealerHole) const
 {
-    std::cout << "\n═════════════════════════════════\n";
-    std::cout << "            BLACKJACK\n";
-    std::cout << "═════════════════════════════════\n";
+    AllocScope scope(AllocSite::Display);
+    out << "\n═════════════════════════════════\n";
+    out << "            BLACKJACK\n";
+    out << "═════════════════════════════════\n";
 
-    std::cout << "Dealer:\n";
+    out << "Dealer:\n";
     if (showDealerHole)
     {
-        std::cout << dealer.getAsciiArt();
-        std::cout << "Total: " << dealer.handValue() << "\n";
+        out << dealer.getAsciiArt();
+        out << "Total: " << dealer.handValue() << "\n";
     }
     else
     {
-        std::cout << dealer.getSecondCardAscii() << "\n";
+        out << dealer.getSecondCardAscii() << "\n";
     }
 
-    std::cout << "\n"
-              << player.getName() << ":\n";
-    std::cout << player.getAsciiArt();
-    std::cout << "Total: " << player.handValue() << "\n\n";
+    out << "\n"
+        << player.getName() << ":\n";
+    out << player.getAsciiArt();
+    out << "Total: " << player.handValue() << "\n\n";
 }
 
 /**
- * @brief Displays the result of a Blackjack round for a given player, updates scores and logs the outcome.
+ * @brief Displays the result of a Blackjack round for a given player, updates statistics and logs the outcome.
  *
  * This function shows both the player's and dealer's hands, determines the outcome of the round
- * (Victory, Defeat, or Tie), updates the player's status and balance accordingly, and optionally
- * updates a provided scores map. The result is appended to a "scores.txt" log file with a timestamp,
- * and a summary is printed to the console.
+ * (Victory, Defeat, or Tie), updates the player's status and balance accordingly, and records the
+ * hand in the session statistics. The result is appended to a "scores.txt" log file with a timestamp,
+ * the full hand is recorded in the binary hand history, and a summary is printed to the console.
  *
  * @param player The player whose result is being shown. The player's status and balance may be modified.
- * @param scores Optional pointer to a map storing cumulative scores for each player by name. If provided,
- *               the player's score is incremented based on the round's outcome (1.0 for win, 0.5 for tie, 0.0 for loss).
+ * @param seat The player's seat index at the table, recorded in the hand history.
  */
-void Game::showResult(const Player &player, std::map<std::string, double> *scores)
+void Game::showResult(const Player &player, int seat)
 {
+    AllocScope scope(AllocSite::Log);
     showHands(player, true);
     int playerScore = player.handValue();
     int dealerScore = dealer.handValue();
 
-    std::string result;
-    double score = 0.0;
+    Outcome outcome = judge(playerScore, dealerScore);
+    std::string result = outcomeName(outcome);
+    double netUnits = 0.0;
 
-    if (playerScore > 21)
+    switch (outcome)
     {
-        result = "Defeat";
-        const_cast<Player &>(player).lose();
-    }
-    else if (dealerScore > 21 || playerScore > dealerScore)
-    {
-        result = "Victory";
+    case Outcome::Victory:
         const_cast<Player &>(player).win();
-        score = 1.0;
-    }
-    else if (playerScore < dealerScore)
-    {
-        result = "Defeat";
-        const_cast<Player &>(player).lose();
-    }
-    else
-    {
-        result = "Tie";
+        netUnits = 1.0;
+        break;
+    case Outcome::Tie:
         const_cast<Player &>(player).tie();
-        score = 0.5;
+        break;
+    case Outcome::Defeat:
+        const_cast<Player &>(player).lose();
+        netUnits = -1.0;
+        break;
     }
 
-    if (scores)
-    {
-        (*scores)[player.getName()] += score;
-    }
+    stats.record(player.getHand(), dealer.getHand()[1], dealerScore, outcome, netUnits);
 
-    std::ofstream file("scores.txt", std::ios::app);
-    std::time_t now = std::time(nullptr);
-    file << "[" << std::ctime(&now) << "] "
-         << player.getName() << ": " << playerScore
-         << " | Dealer: " << dealerScore
-         << " → " << result
-         << " | Solde: " << player.getBalance() << " tokens\n";
+    history.append(roundId, seat, player, dealer, outcome);
 
-    std::cout << "Result for " << player.getName() << " : " << result
-              << " | Current balance : " << player.getBalance() << " tokens\n";
+    scores.append(player.getName(), playerScore, dealerScore, outcome, player.getBalance());
+
+    out << "Result for " << player.getName() << " : " << result
+        << " | Current balance : " << player.getBalance() << " tokens\n";
 }
 
 /**
- * @brief Displays the score history from the "scores.txt" file.
+ * @brief Displays the score summary and history.
  *
- * This function attempts to open the "scores.txt" file and prints its contents
- * to the standard output. If the file does not exist or cannot be opened,
- * it notifies the user that no score is recorded. The output is formatted
- * with a header and footer for clarity.
+ * Players' totals over the compacted (older) part of the log are shown first, followed by the
+ * lines of the live "scores.txt" segment. If nothing was ever recorded, it notifies the user
+ * that no score is recorded. If hands were played in this session, their outcome statistics
+ * per decision are shown afterwards.
  *
  * @note This function does not modify any class members and is marked as const.
  */
 void Game::displayScores() const
 {
-    std::ifstream file("scores.txt");
-    if (!file)
+    if (!scores.print(out))
     {
-        std::cout << "No score recorded.\n";
-        return;
+        out << "No score recorded.\n";
     }
 
-    std::cout << "\n===== SCORE HISTORY =====\n";
-    std::string line;
-    while (std::getline(file, line))
+    if (stats.handCount() > 0)
     {
-        std::cout << line << "\n";
+        out << "\n===== SESSION STATISTICS =====\n";
+        stats.report(out);
+        out << "=================================\n";
     }
-    std::cout << "=================================\n";
 }
\ No newline at end of file
@@ -1,10 +1,18 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "Advisor.h"
+#include "AllocStats.h"
 #include "Deck.h"
+#include "HandHistory.h"
+#include "Input.h"
+#include "OutcomeStats.h"
 #include "Player.h"
+#include "ScoreLog.h"
+#include "ShoeQueue.h"
+#include <memory>
+#include <ostream>
 #include <vector>
-#include <map>
 
 /**
  * @class Game
@@ -15,38 +23,67 @@
  * games and tournament play. The class also provides functionality to display player scores.
  *
  * Private Members:
+ * - Input& input: Where player answers come from (console or action script).
+ * - std::ostream& out: Where the game is rendered (console or a null sink).
  * - Deck deck: The deck of cards used in the game.
+ * - std::unique_ptr<ShoeQueue> shoes: Optional background supplier of pre-shuffled decks.
  * - std::vector<Player> players: The list of players participating in the game.
  * - Player dealer: The dealer for the game.
+ * - ScoreLog scores: Rotated, compacted text log of every settled hand ("scores.txt").
+ * - HandHistoryWriter history: Binary hand-history log ("history.bjh") of every settled hand.
+ * - std::int64_t roundId: Id of the current round, continuing from the last one in "history.bjh".
+ * - OutcomeStats stats: Outcome statistics per decision for every hand settled in this session.
+ * - std::unique_ptr<Advisor> advisor: Optional hit/stand advisor shown on each decision.
+ * - AllocCounters roundStart: Allocation counters when the current round started (instrumented builds).
  *
  * Private Methods:
  * - void playRound(): Conducts a single round of Blackjack for all players and the dealer.
  * - void playerTurn(Player& player): Manages the actions for a player's turn.
  * - void dealerTurn(): Manages the dealer's turn according to Blackjack rules.
  * - void showHands(const Player& player, bool showDealerHole) const: Displays the hands of the player and dealer.
- * - void showResult(const Player& player, std::map<std::string, double>* scores = nullptr): Shows the result for a player, optionally updating scores.
+ * - void showResult(const Player& player, int seat): Shows and settles the result for a player, updating the statistics.
+ * - void reveal(const Card& card): Tells the advisor, if any, that a card was dealt face up.
+ * - void collectCards(): Returns the round's cards to a continuous shuffling machine, if one is used.
+ * - void reportAllocations(): Shows the allocations and card copies of the round just settled (instrumented builds).
  *
  * Public Methods:
- * - Game(): Constructs a new Game instance, initializing players and deck.
+ * - Game(Input& input, std::ostream& out, std::size_t shoeQueueDepth = 0): Constructs a new Game instance,
+ *   initializing players and deck. A non-zero depth shuffles decks ahead of time on a background thread.
+ * - void setAdvisor(bool enabled): Shows (or hides) the best action and its EV before each decision.
+ * - void setContinuousShuffle(bool enabled): Deals from a continuous shuffling machine instead of a fresh deck per round (stops any shoe queue).
  * - void playSingleGame(): Starts and manages a single game session.
  * - void playTournament(): Runs a tournament consisting of multiple game sessions.
- * - void displayScores() const: Displays the current scores of all players.
+ * - void displayScores() const: Displays the score summary and history, and the session statistics.
  */
 class Game
 {
 private:
+    Input &input;
+    std::ostream &out;
     Deck deck;
+    std::unique_ptr<ShoeQueue> shoes;
     std::vector<Player> players;
     Player dealer;
+    ScoreLog scores;
+    HandHistoryWriter history;
+    std::int64_t roundId = 0;
+    OutcomeStats stats;
+    std::unique_ptr<Advisor> advisor;
+    AllocCounters roundStart;
 
     void playRound();
     void playerTurn(Player &player);
     void dealerTurn();
     void showHands(const Player &player, bool showDealerHole) const;
-    void showResult(const Player &player, std::map<std::string, double> *scores = nullptr);
+    void showResult(const Player &player, int seat);
+    void reveal(const Card &card);
+    void collectCards();
+    void reportAllocations();
 
 public:
-    Game();
+    Game(Input &input, std::ostream &out, std::size_t shoeQueueDepth = 0);
+    void setAdvisor(bool enabled);
+    void setContinuousShuffle(bool enabled);
     void playSingleGame();
     void playTournament();
     void displayScores() const;
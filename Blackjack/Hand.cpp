@@ -10,7 +10,15 @@
  */
 void Hand::add(const Card &card)
 {
-    cards.push_back(card);
+    cards[count++] = card;
+}
+
+/**
+ * @brief Removes every card from the hand, keeping its storage for reuse.
+ */
+void Hand::clear()
+{
+    count = 0;
 }
 
 /**
@@ -27,7 +35,7 @@ int Hand::value() const
 {
     int val = 0;
     int aces = 0;
-    for (const auto &c : cards)
+    for (const auto &c : *this)
     {
         int r = c.getRank();
         if (r > 10)
@@ -50,6 +58,24 @@ int Hand::value() const
     return val;
 }
 
+/**
+ * @brief Tells whether the hand is soft, i.e. an ace is still counted as 11.
+ *
+ * @return true if value() includes an ace valued at 11, false otherwise.
+ */
+bool Hand::isSoft() const
+{
+    int val = 0;
+    bool ace = false;
+    for (const auto &c : *this)
+    {
+        int r = c.getRank();
+        val += r > 10 ? 10 : r;
+        ace = ace || r == 1;
+    }
+    return ace && val + 10 <= 21;
+}
+
 /**
  * @brief Returns a string representation of the hand.
  *
@@ -61,7 +87,7 @@ int Hand::value() const
 std::string Hand::toString() const
 {
     std::ostringstream os;
-    for (const auto &c : cards)
+    for (const auto &c : *this)
     {
         os << c.toString() << " ";
     }
@@ -83,7 +109,7 @@ std::string Hand::getAsciiArt() const
 {
     std::stringstream top, mid, bot;
 
-    for (const Card &card : cards)
+    for (const Card &card : *this)
     {
         std::string value = card.getDisplayValue();
         std::string suit = card.getSuitSymbol();
@@ -99,7 +125,22 @@ std::string Hand::getAsciiArt() const
     return top.str() + "\n" + mid.str() + "\n" + bot.str() + "\n";
 }
 
-const std::vector<Card> &Hand::getCards() const
+std::size_t Hand::size() const
+{
+    return count;
+}
+
+const Card &Hand::operator[](std::size_t i) const
+{
+    return cards[i];
+}
+
+const Card *Hand::begin() const
+{
+    return cards.data();
+}
+
+const Card *Hand::end() const
 {
-    return cards;
+    return cards.data() + count;
 }
@@ -2,7 +2,8 @@
 #define HAND_H
 
 #include "Card.h"
-#include <vector>
+#include <array>
+#include <cstddef>
 #include <string>
 
 /**
@@ -12,18 +13,31 @@
  * The Hand class manages a collection of Card objects, providing
  * functionality to add cards, calculate the hand's value, and
  * generate string or ASCII art representations of the hand.
+ *
+ * @note Cards are stored inline, so building and clearing a hand never
+ *       touches the heap. MaxCards covers the longest legal hand from any
+ *       shoe: 21 single-value aces plus the card that busts them.
  */
 class Hand
 {
 public:
+    static constexpr std::size_t MaxCards = 22;
+
     void add(const Card &card);
+    void clear();
     int value() const;
+    bool isSoft() const;
     std::string toString() const;
     std::string getAsciiArt() const;
-    const std::vector<Card> &getCards() const;
+
+    std::size_t size() const;
+    const Card &operator[](std::size_t i) const;
+    const Card *begin() const;
+    const Card *end() const;
 
 private:
-    std::vector<Card> cards;
+    std::array<Card, MaxCards> cards;
+    std::size_t count = 0;
 };
 
 #endif
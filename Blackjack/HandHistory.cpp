@@ -0,0 +1,364 @@
+#include "HandHistory.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+namespace
+{
+    const char Magic[4] = {'B', 'J', 'H', 'H'};
+    const std::uint16_t Version = 1;
+
+    enum Encoding : std::uint8_t
+    {
+        FrameOfReference = 0,
+        DeltaZigzag = 1
+    };
+
+    template <typename T>
+    void put(std::vector<std::uint8_t> &out, T value)
+    {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    T get(const std::uint8_t *&in)
+    {
+        T value;
+        std::memcpy(&value, in, sizeof(T));
+        in += sizeof(T);
+        return value;
+    }
+
+    template <typename T>
+    void write(std::ofstream &file, T value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool read(std::ifstream &file, T &value)
+    {
+        return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+
+    int bitWidth(std::uint64_t v)
+    {
+        int width = 0;
+        while (v)
+        {
+            ++width;
+            v >>= 1;
+        }
+        return width;
+    }
+
+    std::uint64_t zigzag(std::int64_t v)
+    {
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t v)
+    {
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    /**
+     * Encodes a column as a base value plus fixed-width unsigned codes.
+     * For frame-of-reference the codes are offsets from the minimum; for
+     * delta encoding they are zigzagged differences from the previous value.
+     */
+    void encode(const std::vector<std::int64_t> &values, Encoding encoding, std::vector<std::uint8_t> &out)
+    {
+        std::int64_t base = 0;
+        std::uint64_t widest = 0;
+        if (!values.empty())
+        {
+            if (encoding == DeltaZigzag)
+            {
+                base = values.front();
+                for (std::size_t i = 1; i < values.size(); ++i)
+                    widest |= zigzag(values[i] - values[i - 1]);
+            }
+            else
+            {
+                base = values.front();
+                for (std::int64_t v : values)
+                    base = std::min(base, v);
+                for (std::int64_t v : values)
+                    widest |= static_cast<std::uint64_t>(v - base);
+            }
+        }
+        int width = bitWidth(widest);
+
+        put<std::int64_t>(out, base);
+        put<std::uint8_t>(out, static_cast<std::uint8_t>(width));
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(values.size()));
+        if (width == 0)
+            return;
+
+        std::uint64_t acc = 0;
+        int bits = 0;
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            std::uint64_t code;
+            if (encoding == DeltaZigzag)
+                code = i == 0 ? 0 : zigzag(values[i] - values[i - 1]);
+            else
+                code = static_cast<std::uint64_t>(values[i] - base);
+
+            for (int b = 0; b < width; ++b)
+            {
+                acc |= ((code >> b) & 1u) << bits;
+                if (++bits == 8)
+                {
+                    out.push_back(static_cast<std::uint8_t>(acc));
+                    acc = 0;
+                    bits = 0;
+                }
+            }
+        }
+        if (bits)
+            out.push_back(static_cast<std::uint8_t>(acc));
+    }
+
+    const std::size_t PayloadHeader = sizeof(std::int64_t) + sizeof(std::uint8_t) + sizeof(std::uint32_t);
+
+    // Format limit on the rows of one chunk, so corrupt counts cannot request unbounded memory
+    const std::uint32_t MaxChunkRows = 1u << 20;
+
+    /**
+     * Decodes a block written by encode(). Fails when the encoding or bit width is
+     * unknown, when there are more than @p maxCount values, or when the block is too
+     * short for its value count.
+     */
+    bool decode(const std::vector<std::uint8_t> &in, std::uint8_t encoding, std::uint64_t maxCount,
+                std::vector<std::int64_t> &out)
+    {
+        if (in.size() < PayloadHeader || (encoding != FrameOfReference && encoding != DeltaZigzag))
+            return false;
+        const std::uint8_t *p = in.data();
+        std::int64_t base = get<std::int64_t>(p);
+        int width = get<std::uint8_t>(p);
+        std::uint32_t count = get<std::uint32_t>(p);
+        std::uint64_t packedBytes = (static_cast<std::uint64_t>(count) * static_cast<std::uint64_t>(width) + 7) / 8;
+        if (width > 64 || count > maxCount || packedBytes > in.size() - PayloadHeader)
+            return false;
+
+        out.reserve(out.size() + count);
+        std::size_t bit = 0;
+        std::int64_t previous = base;
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            std::uint64_t code = 0;
+            for (int b = 0; b < width; ++b, ++bit)
+                code |= static_cast<std::uint64_t>((p[bit / 8] >> (bit % 8)) & 1u) << b;
+
+            if (encoding == DeltaZigzag)
+            {
+                if (i > 0)
+                    previous += unzigzag(code);
+                out.push_back(previous);
+            }
+            else
+            {
+                out.push_back(base + static_cast<std::int64_t>(code));
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Opens (or creates) a hand-history file for appending.
+ *
+ * The file header is written only when the file is new or empty.
+ *
+ * @param path Location of the history file.
+ * @param rowsPerChunk Number of hands buffered before a chunk is written.
+ */
+HandHistoryWriter::HandHistoryWriter(const std::string &path, std::size_t rowsPerChunk)
+    : rowsPerChunk(std::min<std::size_t>(std::max<std::size_t>(rowsPerChunk, 1), MaxChunkRows))
+{
+    std::error_code ec;
+    bool fresh = !std::filesystem::exists(path, ec) || std::filesystem::file_size(path, ec) == 0;
+    file.open(path, std::ios::binary | std::ios::app);
+    if (fresh && file)
+    {
+        file.write(Magic, sizeof(Magic));
+        write<std::uint16_t>(file, Version);
+    }
+    for (auto &column : columns)
+        column.reserve(this->rowsPerChunk);
+}
+
+HandHistoryWriter::~HandHistoryWriter()
+{
+    flush();
+}
+
+void HandHistoryWriter::push(HistoryColumn column, std::int64_t value)
+{
+    columns[static_cast<int>(column)].push_back(value);
+}
+
+/**
+ * @brief Records one settled hand.
+ *
+ * The player's actions are reconstructed from the hand: every card after the
+ * first two is a hit, and a hand that did not bust ends with a stand.
+ *
+ * @param roundId Identifier of the round the hand belongs to.
+ * @param seat Seat index of the player at the table.
+ * @param player The player, after settlement.
+ * @param dealer The dealer, with the final dealer hand.
+ * @param outcome The result of the hand.
+ */
+void HandHistoryWriter::append(std::int64_t roundId, int seat, const Player &player, const Player &dealer, Outcome outcome)
+{
+    const Hand &hand = player.getHand();
+    const Hand &dealerHand = dealer.getHand();
+
+    push(HistoryColumn::RoundId, roundId);
+    push(HistoryColumn::Seat, seat);
+
+    push(HistoryColumn::PlayerCardCount, static_cast<std::int64_t>(hand.size()));
+    for (const Card &c : hand)
+        push(HistoryColumn::PlayerCards, c.toByte());
+
+    push(HistoryColumn::DealerCardCount, static_cast<std::int64_t>(dealerHand.size()));
+    for (const Card &c : dealerHand)
+        push(HistoryColumn::DealerCards, c.toByte());
+
+    std::size_t hits = hand.size() > 2 ? hand.size() - 2 : 0;
+    bool stood = !player.isBusted();
+    push(HistoryColumn::ActionCount, static_cast<std::int64_t>(hits + (stood ? 1 : 0)));
+    for (std::size_t i = 0; i < hits; ++i)
+        push(HistoryColumn::Actions, 0);
+    if (stood)
+        push(HistoryColumn::Actions, 1);
+
+    push(HistoryColumn::Bet, player.getBet());
+    push(HistoryColumn::PlayerTotal, player.handValue());
+    push(HistoryColumn::DealerTotal, dealer.handValue());
+    push(HistoryColumn::Outcome, static_cast<std::int64_t>(outcome));
+
+    if (++rows >= rowsPerChunk)
+        flush();
+}
+
+/**
+ * @brief Writes the buffered hands as one chunk and clears the buffers.
+ */
+void HandHistoryWriter::flush()
+{
+    if (rows == 0 || !file)
+        return;
+
+    const int columnCount = static_cast<int>(HistoryColumn::Count);
+    write<std::uint32_t>(file, static_cast<std::uint32_t>(rows));
+    write<std::uint8_t>(file, static_cast<std::uint8_t>(columnCount));
+    for (int c = 0; c < columnCount; ++c)
+    {
+        Encoding encoding = c == static_cast<int>(HistoryColumn::RoundId) ? DeltaZigzag : FrameOfReference;
+        block.clear();
+        encode(columns[c], encoding, block);
+
+        write<std::uint8_t>(file, static_cast<std::uint8_t>(c));
+        write<std::uint8_t>(file, encoding);
+        write<std::uint32_t>(file, static_cast<std::uint32_t>(block.size()));
+        file.write(reinterpret_cast<const char *>(block.data()), static_cast<std::streamsize>(block.size()));
+        columns[c].clear();
+    }
+    file.flush();
+    rows = 0;
+}
+
+/**
+ * @brief Opens a hand-history file and checks its header.
+ *
+ * @param path Location of the history file.
+ */
+HandHistoryReader::HandHistoryReader(const std::string &path) : file(path, std::ios::binary)
+{
+    char magic[sizeof(Magic)];
+    std::uint16_t version = 0;
+    valid = file.read(magic, sizeof(magic)) && std::memcmp(magic, Magic, sizeof(Magic)) == 0 &&
+            read(file, version) && version == Version;
+}
+
+bool HandHistoryReader::isOpen() const
+{
+    return valid;
+}
+
+/**
+ * @brief Decodes a single column across every chunk of the file.
+ *
+ * Blocks belonging to other columns are skipped without being read. Every size
+ * and count read from the file is checked against the bytes actually left, so a
+ * truncated or corrupt file stops the scan instead of being read out of bounds.
+ *
+ * @param column The column to extract.
+ * @param values Receives the column's values from every complete, valid chunk, in file order.
+ * @return bool false if the file is not a hand history or a chunk is truncated or corrupt.
+ */
+bool HandHistoryReader::readColumn(HistoryColumn column, std::vector<std::int64_t> &values)
+{
+    values.clear();
+    if (!valid)
+        return false;
+
+    file.clear();
+    file.seekg(0, std::ios::end);
+    std::uint64_t end = static_cast<std::uint64_t>(file.tellg());
+    file.seekg(sizeof(Magic) + sizeof(Version));
+
+    std::vector<std::uint8_t> block;
+    std::vector<std::int64_t> chunk;
+    std::uint32_t rows;
+    std::uint8_t columnCount;
+    while (read(file, rows))
+    {
+        if (rows > MaxChunkRows || !read(file, columnCount))
+            return false;
+        // Card columns hold at most Hand::MaxCards values per row
+        std::uint64_t maxCount = static_cast<std::uint64_t>(rows) * Hand::MaxCards;
+        chunk.clear();
+        for (int c = 0; c < columnCount; ++c)
+        {
+            std::uint8_t id, encoding;
+            std::uint32_t size;
+            if (!read(file, id) || !read(file, encoding) || !read(file, size))
+                return false;
+            std::uint64_t position = static_cast<std::uint64_t>(file.tellg());
+            if (size > end - position)
+                return false;
+
+            if (id != static_cast<std::uint8_t>(column))
+            {
+                file.seekg(size, std::ios::cur);
+                continue;
+            }
+            block.resize(size);
+            if (!file.read(reinterpret_cast<char *>(block.data()), size) || !decode(block, encoding, maxCount, chunk))
+                return false;
+        }
+        values.insert(values.end(), chunk.begin(), chunk.end());
+    }
+    return file.eof() && file.gcount() == 0;
+}
+
+/**
+ * @brief Largest round id recorded in the file, so a new session can continue numbering.
+ *
+ * @return std::int64_t The last round id, or 0 if the file holds no readable hand.
+ */
+std::int64_t HandHistoryReader::lastRoundId()
+{
+    std::vector<std::int64_t> ids;
+    readColumn(HistoryColumn::RoundId, ids);
+    return ids.empty() ? 0 : *std::max_element(ids.begin(), ids.end());
+}
@@ -0,0 +1,96 @@
+#ifndef HAND_HISTORY_H
+#define HAND_HISTORY_H
+
+#include "Player.h"
+#include "Rules.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @enum HistoryColumn
+ * @brief The columns of a binary hand history.
+ *
+ * Variable-length data (cards, actions) is split into a per-hand count column
+ * and a flat value column, so every column holds plain integers.
+ * Card values are Card::toByte() bytes; actions are 0 for hit and 1 for stand.
+ */
+enum class HistoryColumn : std::uint8_t
+{
+    RoundId,
+    Seat,
+    PlayerCardCount,
+    PlayerCards,
+    DealerCardCount,
+    DealerCards,
+    ActionCount,
+    Actions,
+    Bet,
+    PlayerTotal,
+    DealerTotal,
+    Outcome,
+    Count
+};
+
+/**
+ * @class HandHistoryWriter
+ * @brief Streams settled hands to a compact columnar binary file.
+ *
+ * Hands are buffered column by column and written in chunks. Inside a chunk each
+ * column is stored as its own block, prefixed with its byte length, and encoded
+ * either as bit-packed offsets from the column minimum or, for the round id, as
+ * bit-packed zigzag deltas. Readers can therefore skip straight over the
+ * columns they do not need.
+ *
+ * File layout:
+ * - header: "BJHH", u16 version
+ * - chunk:  u32 row count (at most 2^20), u8 column count, then per column:
+ *           u8 column id, u8 encoding, u32 payload size, payload
+ * - payload: i64 base, u8 bit width, u32 value count, packed bits
+ *
+ * @note The writer appends to an existing file; buffered rows are flushed
+ *       when a chunk fills up and when the writer is destroyed.
+ */
+class HandHistoryWriter
+{
+public:
+    explicit HandHistoryWriter(const std::string &path, std::size_t rowsPerChunk = 4096);
+    ~HandHistoryWriter();
+
+    void append(std::int64_t roundId, int seat, const Player &player, const Player &dealer, Outcome outcome);
+    void flush();
+
+private:
+    std::ofstream file;
+    std::size_t rowsPerChunk;
+    std::size_t rows = 0;
+    std::vector<std::int64_t> columns[static_cast<int>(HistoryColumn::Count)];
+    std::vector<std::uint8_t> block;
+
+    void push(HistoryColumn column, std::int64_t value);
+};
+
+/**
+ * @class HandHistoryReader
+ * @brief Reads individual columns back from a file written by HandHistoryWriter.
+ *
+ * Only the requested column is decoded; the blocks of every other column are
+ * skipped by seeking over them. Truncated or corrupt files are detected and
+ * reported rather than read past their end.
+ */
+class HandHistoryReader
+{
+public:
+    explicit HandHistoryReader(const std::string &path);
+
+    bool isOpen() const;
+    bool readColumn(HistoryColumn column, std::vector<std::int64_t> &values);
+    std::int64_t lastRoundId();
+
+private:
+    std::ifstream file;
+    bool valid = false;
+};
+
+#endif
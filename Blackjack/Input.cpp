@@ -0,0 +1,158 @@
+#include "Input.h"
+#include <cctype>
+#include <climits>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool ConsoleInput::readInt(int &value)
+{
+    if (std::cin >> value)
+        return true;
+    if (!std::cin.eof())
+    {
+        // Discard the rest of the unreadable token so the next prompt can try again.
+        // An out-of-range number has already been consumed, so stop at whitespace.
+        std::cin.clear();
+        while (std::cin.peek() != EOF && !std::isspace(std::cin.peek()))
+            std::cin.get();
+        value = 0;
+        return true;
+    }
+    return false;
+}
+
+bool ConsoleInput::readChar(char &value)
+{
+    return static_cast<bool>(std::cin >> value);
+}
+
+bool ConsoleInput::readLine(std::string &line)
+{
+    return static_cast<bool>(std::getline(std::cin >> std::ws, line));
+}
+
+/**
+ * @brief Maps the script file into memory.
+ *
+ * @param path Location of the action script. Use isOpen() to check it was mapped.
+ */
+ScriptInput::ScriptInput(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0)
+    {
+        mapped = true;
+        if (info.st_size > 0)
+        {
+            void *p = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                mapped = false;
+            }
+            else
+            {
+                data = static_cast<const char *>(p);
+                size = static_cast<std::size_t>(info.st_size);
+                ::madvise(p, size, MADV_SEQUENTIAL);
+            }
+        }
+    }
+    ::close(fd);
+}
+
+ScriptInput::~ScriptInput()
+{
+    if (data)
+        ::munmap(const_cast<char *>(data), size);
+}
+
+bool ScriptInput::isOpen() const
+{
+    return mapped;
+}
+
+/**
+ * @brief Advances past whitespace.
+ *
+ * @return true if a token follows, false at the end of the script.
+ */
+bool ScriptInput::skipSpace()
+{
+    while (pos < size && std::isspace(static_cast<unsigned char>(data[pos])))
+        ++pos;
+    return pos < size;
+}
+
+/**
+ * @brief Parses a decimal integer.
+ *
+ * A token that is not a number, or does not fit in an int, is skipped and
+ * reads as 0, like ConsoleInput does.
+ */
+bool ScriptInput::readInt(int &value)
+{
+    if (!skipSpace())
+        return false;
+
+    bool negative = data[pos] == '-';
+    if (negative || data[pos] == '+')
+        ++pos;
+    const long long limit = negative ? -static_cast<long long>(INT_MIN) : INT_MAX;
+    long long v = 0;
+    bool digits = false;
+    bool overflow = false;
+    while (pos < size && data[pos] >= '0' && data[pos] <= '9')
+    {
+        // Stop accumulating once out of range; the digits are still consumed
+        if (!overflow)
+        {
+            v = v * 10 + (data[pos] - '0');
+            overflow = v > limit;
+        }
+        ++pos;
+        digits = true;
+    }
+    if (!digits || overflow)
+    {
+        while (pos < size && !std::isspace(static_cast<unsigned char>(data[pos])))
+            ++pos;
+        value = 0;
+        return true;
+    }
+    value = static_cast<int>(negative ? -v : v);
+    return true;
+}
+
+bool ScriptInput::readChar(char &value)
+{
+    if (!skipSpace())
+        return false;
+    value = data[pos++];
+    return true;
+}
+
+/**
+ * @brief Reads the rest of the line, starting at the next non-blank character.
+ */
+bool ScriptInput::readLine(std::string &line)
+{
+    if (!skipSpace())
+        return false;
+
+    std::size_t start = pos;
+    while (pos < size && data[pos] != '\n')
+        ++pos;
+    std::size_t end = pos;
+    if (end > start && data[end - 1] == '\r')
+        --end;
+    line.assign(data + start, end - start);
+    return true;
+}
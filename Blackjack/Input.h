@@ -0,0 +1,68 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class Input
+ * @brief Source of the answers the game asks for (menu choices, names, bets, h/s).
+ *
+ * Every read skips leading whitespace, including line breaks. When the input is
+ * exhausted a read returns false, and callers fall back to the most
+ * conservative answer (quit, minimum bet, stand).
+ */
+class Input
+{
+public:
+    virtual ~Input() = default;
+
+    virtual bool readInt(int &value) = 0;
+    virtual bool readChar(char &value) = 0;
+    virtual bool readLine(std::string &line) = 0;
+};
+
+/**
+ * @class ConsoleInput
+ * @brief Reads answers interactively from standard input.
+ */
+class ConsoleInput : public Input
+{
+public:
+    bool readInt(int &value) override;
+    bool readChar(char &value) override;
+    bool readLine(std::string &line) override;
+};
+
+/**
+ * @class ScriptInput
+ * @brief Reads answers from a memory-mapped action script.
+ *
+ * The script is the text a player would type, e.g. "1\n2\nAlice\nBob\n10\nh\ns\n...".
+ * Tokens are parsed directly from the mapped bytes, without going through
+ * iostreams, so the interactive code paths can be driven at full speed.
+ */
+class ScriptInput : public Input
+{
+public:
+    explicit ScriptInput(const std::string &path);
+    ~ScriptInput() override;
+
+    ScriptInput(const ScriptInput &) = delete;
+    ScriptInput &operator=(const ScriptInput &) = delete;
+
+    bool isOpen() const;
+    bool readInt(int &value) override;
+    bool readChar(char &value) override;
+    bool readLine(std::string &line) override;
+
+private:
+    const char *data = nullptr;
+    std::size_t size = 0;
+    std::size_t pos = 0;
+    bool mapped = false;
+
+    bool skipSpace();
+};
+
+#endif
@@ -0,0 +1,241 @@
+#include "Leaderboard.h"
+#include <algorithm>
+#include <mutex>
+
+Leaderboard::Leaderboard() : rng(std::random_device{}()) {}
+
+/**
+ * @brief Tells whether a key ranks ahead of a node.
+ *
+ * Higher balances rank first; equal balances are ordered by name, then by id.
+ */
+bool Leaderboard::before(const Node &key, int node) const
+{
+    const Node &n = nodes[node];
+    if (key.balance != n.balance)
+        return key.balance > n.balance;
+    if (key.name != n.name)
+        return key.name < n.name;
+    return key.id < n.id;
+}
+
+std::size_t Leaderboard::count(int node) const
+{
+    return node < 0 ? 0 : nodes[node].count;
+}
+
+void Leaderboard::pull(int node)
+{
+    nodes[node].count = 1 + count(nodes[node].left) + count(nodes[node].right);
+}
+
+/**
+ * @brief Splits a subtree into nodes ranked ahead of the key and the rest.
+ */
+void Leaderboard::split(int node, const Node &key, int &left, int &right)
+{
+    if (node < 0)
+    {
+        left = right = -1;
+        return;
+    }
+    if (before(key, node))
+    {
+        split(nodes[node].left, key, left, nodes[node].left);
+        right = node;
+    }
+    else
+    {
+        split(nodes[node].right, key, nodes[node].right, right);
+        left = node;
+    }
+    pull(node);
+}
+
+/**
+ * @brief Joins two subtrees where every node of @p left ranks ahead of @p right.
+ */
+int Leaderboard::merge(int left, int right)
+{
+    if (left < 0)
+        return right;
+    if (right < 0)
+        return left;
+    if (nodes[left].priority > nodes[right].priority)
+    {
+        nodes[left].right = merge(nodes[left].right, right);
+        pull(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    pull(right);
+    return right;
+}
+
+/**
+ * @brief Unlinks node @p target from a subtree.
+ *
+ * @return int The new root of the subtree.
+ */
+int Leaderboard::erase(int node, int target)
+{
+    if (node < 0)
+        return -1;
+    if (node == target)
+        return merge(nodes[node].left, nodes[node].right);
+    Node &n = nodes[node];
+    if (before(nodes[target], node))
+        n.left = erase(n.left, target);
+    else
+        n.right = erase(n.right, target);
+    pull(node);
+    return node;
+}
+
+/**
+ * @brief Inserts a player or moves an existing one to a new balance.
+ *
+ * @param id The player's unique id, used as the key.
+ * @param name The player's name, shown in the ranking.
+ * @param balance The player's current balance.
+ */
+void Leaderboard::update(std::size_t id, const std::string &name, int balance)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    int node;
+    auto it = byId.find(id);
+    if (it != byId.end())
+    {
+        node = it->second;
+        if (nodes[node].balance == balance && nodes[node].name == name)
+            return;
+        root = erase(root, node);
+    }
+    else
+    {
+        if (freeNodes.empty())
+        {
+            node = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+        }
+        else
+        {
+            node = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        nodes[node].id = id;
+        nodes[node].priority = rng();
+        byId.emplace(id, node);
+    }
+
+    Node &n = nodes[node];
+    n.name = name;
+    n.balance = balance;
+    n.left = n.right = -1;
+    n.count = 1;
+
+    int left, right;
+    split(root, n, left, right);
+    root = merge(merge(left, node), right);
+}
+
+/**
+ * @brief Removes a player, e.g. once they are eliminated.
+ *
+ * @param id The player's id. Unknown ids are ignored.
+ */
+void Leaderboard::remove(std::size_t id)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+
+    auto it = byId.find(id);
+    if (it == byId.end())
+        return;
+    int node = it->second;
+    root = erase(root, node);
+    freeNodes.push_back(node);
+    byId.erase(it);
+}
+
+/**
+ * @brief Removes every player.
+ */
+void Leaderboard::clear()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    nodes.clear();
+    freeNodes.clear();
+    byId.clear();
+    root = -1;
+}
+
+/**
+ * @brief Returns the 1-based rank of a player.
+ *
+ * @param id The player's id.
+ * @return std::size_t The player's rank, or 0 if the player is not ranked.
+ */
+std::size_t Leaderboard::rankOf(std::size_t id) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    auto it = byId.find(id);
+    if (it == byId.end())
+        return 0;
+    int target = it->second;
+
+    std::size_t rank = 0;
+    int node = root;
+    while (node >= 0)
+    {
+        const Node &n = nodes[node];
+        if (node == target)
+            return rank + count(n.left) + 1;
+        if (before(nodes[target], node))
+        {
+            node = n.left;
+        }
+        else
+        {
+            rank += count(n.left) + 1;
+            node = n.right;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the K best-ranked players, best first.
+ *
+ * @param k The maximum number of entries to return.
+ * @return std::vector<LeaderboardEntry> Up to @p k entries in ranking order.
+ */
+std::vector<LeaderboardEntry> Leaderboard::top(std::size_t k) const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+
+    std::vector<LeaderboardEntry> result;
+    result.reserve(std::min(k, byId.size()));
+    std::vector<int> stack;
+    int node = root;
+    while ((node >= 0 || !stack.empty()) && result.size() < k)
+    {
+        while (node >= 0)
+        {
+            stack.push_back(node);
+            node = nodes[node].left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        result.push_back({nodes[node].id, nodes[node].name, nodes[node].balance});
+        node = nodes[node].right;
+    }
+    return result;
+}
+
+std::size_t Leaderboard::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return byId.size();
+}
@@ -0,0 +1,76 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <cstdint>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct LeaderboardEntry
+ * @brief A player's id, name and balance as reported by the leaderboard.
+ */
+struct LeaderboardEntry
+{
+    std::size_t id;
+    std::string name;
+    int balance;
+};
+
+/**
+ * @class Leaderboard
+ * @brief Live ranking of players by balance, updated one player at a time.
+ *
+ * Players are identified by a caller-chosen unique id (e.g. their registration
+ * index), so several players may share a name. They are kept in an
+ * order-statistic treap sorted by balance (highest first, ties broken by name,
+ * then by id). Updating a balance, looking up a player's rank and
+ * reading the top K entries all run in O(log n) (plus K for top), so standings
+ * can be shown after every round without re-sorting the whole field.
+ *
+ * @note All methods are thread-safe: queries take a shared lock and updates an
+ *       exclusive one, so several tables may settle players concurrently.
+ */
+class Leaderboard
+{
+public:
+    Leaderboard();
+
+    void update(std::size_t id, const std::string &name, int balance);
+    void remove(std::size_t id);
+    void clear();
+
+    std::size_t rankOf(std::size_t id) const;
+    std::vector<LeaderboardEntry> top(std::size_t k) const;
+    std::size_t size() const;
+
+private:
+    struct Node
+    {
+        std::size_t id = 0;
+        std::string name;
+        int balance = 0;
+        std::uint32_t priority = 0;
+        int left = -1;
+        int right = -1;
+        std::size_t count = 1;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::unordered_map<std::size_t, int> byId;
+    int root = -1;
+    std::mt19937 rng;
+    mutable std::shared_mutex mutex;
+
+    bool before(const Node &key, int node) const;
+    std::size_t count(int node) const;
+    void pull(int node);
+    void split(int node, const Node &key, int &left, int &right);
+    int merge(int left, int right);
+    int erase(int node, int target);
+};
+
+#endif
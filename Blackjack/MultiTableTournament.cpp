@@ -0,0 +1,174 @@
+#include "MultiTableTournament.h"
+#include "ShoeSet.h"
+#include <algorithm>
+#include <iomanip>
+#include <string>
+
+MultiTableTournament::TableState::TableState(int numDecks) : deck(numDecks)
+{
+    deck.setLazyShuffle(true);
+    seats.reserve(MaxSeats);
+    players.reserve(MaxSeats);
+    bets.reserve(MaxSeats);
+    outcomes.resize(MaxSeats);
+}
+
+/**
+ * @brief Registers the entrants ("Player 1" to "Player N") and seats them.
+ *
+ * @param config Field size, number of rounds, bet and shoe size.
+ * @param strategy Playing decisions shared by every entrant.
+ * @param pool Threads the tables are played on.
+ */
+MultiTableTournament::MultiTableTournament(const TournamentConfig &config, const Strategy &strategy, ThreadPool &pool)
+    : config(config), strategy(strategy), pool(pool)
+{
+    entrants.reserve(config.entrants);
+    for (std::size_t i = 0; i < config.entrants; ++i)
+    {
+        entrants.emplace_back("Player " + std::to_string(i + 1));
+        leaderboard.update(i, entrants.back().getName(), entrants.back().getBalance());
+    }
+    alive = entrants.size();
+
+    std::size_t tableCount = (alive + MaxSeats - 1) / MaxSeats;
+    tables.reserve(tableCount);
+    for (std::size_t t = 0; t < tableCount; ++t)
+    {
+        tables.emplace_back(config.numDecks);
+        tables.back().deck.seed(static_cast<std::uint32_t>(deriveSeed(config.seed, t)));
+    }
+    for (std::size_t i = 0; i < entrants.size(); ++i)
+        tables[i % tableCount].seats.push_back(i);
+}
+
+/**
+ * @brief Plays one round at a table and posts the new balances.
+ *
+ * Each entrant bets the configured amount, or everything left if less.
+ */
+void MultiTableTournament::playTable(TableState &state)
+{
+    state.players.clear();
+    state.bets.clear();
+    for (std::size_t seat : state.seats)
+    {
+        Player &player = entrants[seat];
+        state.players.push_back(&player);
+        state.bets.push_back(std::min(config.bet, player.getBalance()));
+    }
+
+    state.deck.reset();
+    state.table.playRound(state.deck, state.players.data(), state.bets.data(), state.players.size(),
+                          strategy, state.outcomes.data());
+
+    for (std::size_t seat : state.seats)
+    {
+        leaderboard.update(seat, entrants[seat].getName(), entrants[seat].getBalance());
+    }
+}
+
+/**
+ * @brief Removes players who are out of tokens from their tables and the ranking.
+ */
+void MultiTableTournament::eliminate(std::ostream &out)
+{
+    std::size_t eliminated = 0;
+    for (TableState &state : tables)
+    {
+        auto broke = [this](std::size_t seat)
+        { return entrants[seat].getBalance() <= 0; };
+        for (std::size_t seat : state.seats)
+        {
+            if (broke(seat))
+                leaderboard.remove(seat);
+        }
+        auto end = std::remove_if(state.seats.begin(), state.seats.end(), broke);
+        eliminated += static_cast<std::size_t>(state.seats.end() - end);
+        state.seats.erase(end, state.seats.end());
+    }
+    alive -= eliminated;
+    if (eliminated)
+        out << eliminated << " player(s) eliminated (out of tokens).\n";
+}
+
+/**
+ * @brief Closes surplus tables and evens out the number of seats per table.
+ *
+ * Nothing moves while the field already fits the minimum number of tables
+ * with seat counts differing by at most one. Otherwise every remaining player
+ * is reseated, in current seat order, round-robin over the minimum number of
+ * tables.
+ */
+void MultiTableTournament::rebalance()
+{
+    std::size_t needed = (alive + MaxSeats - 1) / MaxSeats;
+    if (needed == 0)
+    {
+        tables.clear();
+        return;
+    }
+
+    std::size_t fewest = alive, most = 0;
+    for (const TableState &state : tables)
+    {
+        fewest = std::min(fewest, state.seats.size());
+        most = std::max(most, state.seats.size());
+    }
+    if (tables.size() == needed && most - fewest <= 1)
+        return;
+
+    std::vector<std::size_t> remaining;
+    remaining.reserve(alive);
+    for (const TableState &state : tables)
+        remaining.insert(remaining.end(), state.seats.begin(), state.seats.end());
+
+    while (tables.size() > needed)
+        tables.pop_back();
+    for (TableState &state : tables)
+        state.seats.clear();
+    for (std::size_t i = 0; i < remaining.size(); ++i)
+        tables[i % needed].seats.push_back(remaining[i]);
+}
+
+/**
+ * @brief Plays the tournament and prints live standings and the final ranking.
+ *
+ * @param out Stream receiving the tournament report.
+ */
+void MultiTableTournament::run(std::ostream &out)
+{
+    for (int round = 1; round <= config.rounds && alive > 0; ++round)
+    {
+        pool.run(tables.size(), [this](std::size_t t)
+                 { playTable(tables[t]); });
+
+        eliminate(out);
+        rebalance();
+
+        out << "Round " << round << ": " << alive << " player(s) on " << tables.size() << " table(s)";
+        std::vector<LeaderboardEntry> leader = leaderboard.top(1);
+        if (!leader.empty())
+            out << " | leader " << leader.front().name << " (" << leader.front().balance << " tokens)";
+        out << "\n";
+    }
+
+    if (alive == 0)
+    {
+        out << "No players left. Tournament ends.\n";
+        return;
+    }
+
+    out << "\nFINAL RANKING BY BALANCE\n";
+    std::size_t rank = 1;
+    for (const LeaderboardEntry &entry : leaderboard.top(10))
+    {
+        out << std::setw(4) << rank++ << ". " << std::setw(14) << entry.name
+            << " : " << entry.balance << " tokens\n";
+    }
+}
+
+const Leaderboard &MultiTableTournament::getLeaderboard() const
+{
+    return leaderboard;
+}
@@ -0,0 +1,73 @@
+#ifndef MULTI_TABLE_TOURNAMENT_H
+#define MULTI_TABLE_TOURNAMENT_H
+
+#include "Leaderboard.h"
+#include "Strategy.h"
+#include "Table.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @struct TournamentConfig
+ * @brief Parameters of an automated multi-table tournament.
+ */
+struct TournamentConfig
+{
+    std::size_t entrants = 100;
+    int rounds = 10;
+    int bet = 10;
+    int numDecks = 6;
+    std::uint64_t seed = 1;
+};
+
+/**
+ * @class MultiTableTournament
+ * @brief Tournament mode for large fields, played on many tables in parallel.
+ *
+ * Follows the rules of Game::playTournament — everyone starts with 100
+ * tokens, players at zero are eliminated, the final ranking is by balance —
+ * but entrants are automated players following a Strategy. They are spread
+ * over tables of at most MaxSeats seats, and every round the tables are
+ * played in parallel on a ThreadPool. Eliminations are followed by a
+ * rebalance that closes surplus tables and evens out seat counts. Balances are
+ * settled into a shared Leaderboard as each table finishes.
+ */
+class MultiTableTournament
+{
+public:
+    static constexpr std::size_t MaxSeats = 7;
+
+    MultiTableTournament(const TournamentConfig &config, const Strategy &strategy, ThreadPool &pool);
+
+    void run(std::ostream &out);
+    const Leaderboard &getLeaderboard() const;
+
+private:
+    struct TableState
+    {
+        explicit TableState(int numDecks);
+
+        Deck deck;
+        Table table;
+        std::vector<std::size_t> seats;
+        std::vector<Player *> players;
+        std::vector<int> bets;
+        std::vector<Outcome> outcomes;
+    };
+
+    TournamentConfig config;
+    const Strategy &strategy;
+    ThreadPool &pool;
+    std::vector<Player> entrants;
+    std::vector<TableState> tables;
+    Leaderboard leaderboard;
+    std::size_t alive = 0;
+
+    void playTable(TableState &state);
+    void eliminate(std::ostream &out);
+    void rebalance();
+};
+
+#endif
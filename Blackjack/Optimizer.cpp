@@ -0,0 +1,147 @@
+#include "Optimizer.h"
+#include "Table.h"
+#include <algorithm>
+#include <random>
+
+double Evaluation::netPerRound() const
+{
+    return rounds ? static_cast<double>(net) / rounds : 0.0;
+}
+
+/**
+ * @param shoes The shoes every candidate is scored on.
+ * @param penetration Fraction of each shoe dealt before it is abandoned.
+ * @param maxBetUnits Upper bound for any step of the bet ramp.
+ * @param pool Threads used to evaluate shoes in parallel.
+ */
+Optimizer::Optimizer(const ShoeSource &shoes, double penetration, int maxBetUnits, ThreadPool &pool)
+    : shoes(shoes), penetration(penetration), maxBetUnits(maxBetUnits), pool(pool)
+{
+}
+
+/**
+ * @brief Plays one shoe down to the penetration point.
+ *
+ * The deck deals straight from the shoe's bytes without copying them. Enough
+ * cards are always kept back for the longest possible round (two maximal
+ * hands), so a single-deck shoe may stop before its nominal penetration.
+ */
+void Optimizer::playShoe(const std::uint8_t *shoe, const Strategy &strategy, Evaluation &result) const
+{
+    Deck deck(shoes.getNumDecks());
+    deck.attach(shoe, shoes.cardsPerShoe());
+    Table table;
+    Player player("Simulated");
+
+    const std::size_t reserve = std::max<std::size_t>(
+        2 * Hand::MaxCards,
+        static_cast<std::size_t>(shoes.cardsPerShoe() * (1.0 - penetration)));
+
+    int running = 0;
+    while (deck.size() > reserve)
+    {
+        int trueCount = static_cast<int>(running / (deck.size() / 52.0));
+        int bet = strategy.betUnits(trueCount);
+        int before = player.getBalance();
+
+        table.playRound(deck, player, bet, strategy);
+
+        ++result.rounds;
+        result.wagered += bet;
+        result.net += player.getBalance() - before;
+        for (const Card &c : player.getHand())
+            running += hiLoValue(c);
+        for (const Card &c : table.getDealer().getHand())
+            running += hiLoValue(c);
+    }
+}
+
+/**
+ * @brief Scores a strategy on the whole shoe set.
+ *
+ * Shoes are split into blocks that run in parallel; block totals are summed in
+ * a fixed order, so the result does not depend on the number of threads.
+ *
+ * @param strategy The candidate to score.
+ * @return Evaluation Rounds played, units wagered and net units won.
+ */
+Evaluation Optimizer::evaluate(const Strategy &strategy)
+{
+    const std::size_t blocks = std::min<std::size_t>(shoes.size(), pool.size() * 4);
+    std::vector<Evaluation> partial(blocks);
+
+    pool.run(blocks, [&](std::size_t b)
+             {
+                 std::size_t first = shoes.size() * b / blocks;
+                 std::size_t last = shoes.size() * (b + 1) / blocks;
+                 for (std::size_t i = first; i < last; ++i)
+                     playShoe(shoes.shoe(i), strategy, partial[b]); });
+
+    Evaluation total;
+    for (const Evaluation &e : partial)
+    {
+        total.rounds += e.rounds;
+        total.wagered += e.wagered;
+        total.net += e.net;
+    }
+    return total;
+}
+
+/**
+ * @brief Improves a strategy by randomized local search.
+ *
+ * @param start The strategy to start from, e.g. Strategy::basic().
+ * @param iterations Number of candidate changes to try.
+ * @param seed Seed for choosing the changes.
+ * @param log Stream receiving a line for every accepted change.
+ * @return Strategy The best strategy found.
+ */
+Strategy Optimizer::optimize(const Strategy &start, std::size_t iterations, std::uint64_t seed, std::ostream &log)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int> move(0, 2);
+    std::uniform_int_distribution<int> upcard(1, 10);
+    std::uniform_int_distribution<int> hardTotal(8, 18);
+    std::uniform_int_distribution<int> softTotal(13, 20);
+    std::uniform_int_distribution<int> count(Strategy::MinCount, Strategy::MaxCount);
+
+    Strategy best = start;
+    Evaluation bestScore = evaluate(best);
+    log << "start: " << bestScore.netPerRound() << " units/round over " << bestScore.rounds << " rounds\n";
+
+    for (std::size_t it = 1; it <= iterations; ++it)
+    {
+        Strategy candidate = best;
+        switch (move(rng))
+        {
+        case 0:
+        {
+            int total = hardTotal(rng), up = upcard(rng);
+            candidate.setHit(false, total, up, !candidate.getHit(false, total, up));
+            break;
+        }
+        case 1:
+        {
+            int total = softTotal(rng), up = upcard(rng);
+            candidate.setHit(true, total, up, !candidate.getHit(true, total, up));
+            break;
+        }
+        default:
+        {
+            int tc = count(rng);
+            int step = rng() & 1 ? 1 : -1;
+            candidate.setBetUnits(tc, std::clamp(candidate.betUnits(tc) + step, 1, maxBetUnits));
+            break;
+        }
+        }
+
+        Evaluation score = evaluate(candidate);
+        if (score.net > bestScore.net)
+        {
+            best = candidate;
+            bestScore = score;
+            log << "iteration " << it << ": " << bestScore.netPerRound() << " units/round\n";
+        }
+    }
+    return best;
+}
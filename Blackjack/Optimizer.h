@@ -0,0 +1,54 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+
+#include "ShoeSet.h"
+#include "Strategy.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @struct Evaluation
+ * @brief Result of playing a strategy through every shoe of a ShoeSet.
+ */
+struct Evaluation
+{
+    long long rounds = 0;
+    long long wagered = 0;
+    long long net = 0;
+
+    double netPerRound() const;
+};
+
+/**
+ * @class Optimizer
+ * @brief Local search over playing tables and bet ramps using common random numbers.
+ *
+ * Every candidate is scored on the same pre-generated shoes (a ShoeSet or a
+ * memory-mapped ShoeCorpus), so the difference
+ * between two candidates only reflects their decisions and not the luck of the
+ * cards. Shoes are dealt down to the penetration point with a Hi-Lo count
+ * driving the bet ramp, and are evaluated in parallel on a ThreadPool.
+ *
+ * The search starts from a given strategy and repeatedly applies one random
+ * change (flip a hit/stand cell or move one step of the bet ramp), keeping it
+ * when the net result over the shoe set improves.
+ */
+class Optimizer
+{
+public:
+    Optimizer(const ShoeSource &shoes, double penetration, int maxBetUnits, ThreadPool &pool);
+
+    Evaluation evaluate(const Strategy &strategy);
+    Strategy optimize(const Strategy &start, std::size_t iterations, std::uint64_t seed, std::ostream &log);
+
+private:
+    const ShoeSource &shoes;
+    double penetration;
+    int maxBetUnits;
+    ThreadPool &pool;
+
+    void playShoe(const std::uint8_t *shoe, const Strategy &strategy, Evaluation &result) const;
+};
+
+#endif
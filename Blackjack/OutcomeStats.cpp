@@ -0,0 +1,155 @@
+#include "OutcomeStats.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <string>
+
+int OutcomeStats::index(int total, int upcard, Action action)
+{
+    return (std::min(total, 21) * 10 + (upcard - 1)) * 2 + (action == Action::Hit ? 0 : 1);
+}
+
+/**
+ * @brief Adds one hand to the cell (Welford update).
+ */
+void OutcomeStats::Cell::add(double net, Outcome outcome, bool dealerBust)
+{
+    ++count;
+    double delta = net - mean;
+    mean += delta / count;
+    m2 += delta * (net - mean);
+
+    switch (outcome)
+    {
+    case Outcome::Victory:
+        ++wins;
+        break;
+    case Outcome::Tie:
+        ++ties;
+        break;
+    case Outcome::Defeat:
+        ++losses;
+        break;
+    }
+    if (dealerBust)
+        ++dealerBusts;
+
+    int bin = std::clamp(static_cast<int>(std::lround(net)), MinNet, MaxNet) - MinNet;
+    ++histogram[bin];
+}
+
+/**
+ * @brief Combines another cell into this one (Chan et al. parallel update).
+ */
+void OutcomeStats::Cell::merge(const Cell &other)
+{
+    if (other.count == 0)
+        return;
+    long long n = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / n;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+    count = n;
+
+    wins += other.wins;
+    ties += other.ties;
+    losses += other.losses;
+    dealerBusts += other.dealerBusts;
+    for (int i = 0; i <= MaxNet - MinNet; ++i)
+        histogram[i] += other.histogram[i];
+}
+
+double OutcomeStats::Cell::variance() const
+{
+    return count > 1 ? m2 / (count - 1) : 0.0;
+}
+
+/**
+ * @brief Records a settled hand under every decision the player made.
+ *
+ * Decisions are reconstructed from the cards: each card after the first two
+ * is a hit taken at the total before it, and a hand that did not bust ends
+ * with a stand at its final total.
+ *
+ * @param hand The player's final hand.
+ * @param upcard The dealer's visible card.
+ * @param dealerTotal The dealer's final total.
+ * @param outcome The result of the hand.
+ * @param netUnits The net result in bet units (+1 win, 0 tie, -1 loss).
+ */
+void OutcomeStats::record(const Hand &hand, const Card &upcard, int dealerTotal, Outcome outcome, double netUnits)
+{
+    if (hand.size() < 2)
+        return;
+
+    ++hands;
+    int up = upcardValue(upcard);
+    bool dealerBust = dealerTotal > 21;
+
+    Hand prefix;
+    prefix.add(hand[0]);
+    prefix.add(hand[1]);
+    for (std::size_t i = 2; i < hand.size(); ++i)
+    {
+        cells[index(prefix.value(), up, Action::Hit)].add(netUnits, outcome, dealerBust);
+        prefix.add(hand[i]);
+    }
+    if (prefix.value() <= 21)
+        cells[index(prefix.value(), up, Action::Stand)].add(netUnits, outcome, dealerBust);
+}
+
+/**
+ * @brief Adds every cell of another accumulator to this one.
+ */
+void OutcomeStats::merge(const OutcomeStats &other)
+{
+    hands += other.hands;
+    for (std::size_t i = 0; i < cells.size(); ++i)
+        cells[i].merge(other.cells[i]);
+}
+
+/**
+ * @brief Number of hands recorded so far.
+ */
+long long OutcomeStats::handCount() const
+{
+    return hands;
+}
+
+const OutcomeStats::Cell &OutcomeStats::cell(int total, int upcard, Action action) const
+{
+    return cells[index(total, upcard, action)];
+}
+
+/**
+ * @brief Prints one line per non-empty cell: mean, standard deviation,
+ *        win/tie/loss rates and dealer bust rate.
+ *
+ * @param os The stream to print to.
+ */
+void OutcomeStats::report(std::ostream &os) const
+{
+    os << "Total Up Action     Hands     Mean   StdDev   Win%   Tie%  Loss%  Bust%\n";
+    for (int total = 4; total <= 21; ++total)
+    {
+        for (int up = 1; up <= 10; ++up)
+        {
+            for (Action action : {Action::Hit, Action::Stand})
+            {
+                const Cell &c = cell(total, up, action);
+                if (c.count == 0)
+                    continue;
+                double n = static_cast<double>(c.count);
+                os << std::setw(5) << total << std::setw(4) << (up == 1 ? "A" : std::to_string(up))
+                   << std::setw(7) << (action == Action::Hit ? "hit" : "stand")
+                   << std::setw(10) << c.count
+                   << std::fixed << std::setprecision(3)
+                   << std::setw(9) << c.mean << std::setw(9) << std::sqrt(c.variance())
+                   << std::setprecision(1)
+                   << std::setw(7) << 100 * c.wins / n << std::setw(7) << 100 * c.ties / n
+                   << std::setw(7) << 100 * c.losses / n << std::setw(7) << 100 * c.dealerBusts / n
+                   << std::defaultfloat << "\n";
+            }
+        }
+    }
+}
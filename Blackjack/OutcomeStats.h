@@ -0,0 +1,62 @@
+#ifndef OUTCOME_STATS_H
+#define OUTCOME_STATS_H
+
+#include "Hand.h"
+#include "Rules.h"
+#include "Strategy.h"
+#include <array>
+#include <ostream>
+
+/**
+ * @class OutcomeStats
+ * @brief Fixed-size streaming statistics of hand outcomes per decision.
+ *
+ * Every decision of a settled hand — the player's total, the dealer's upcard
+ * and whether the player hit or stood — is a cell. Each cell keeps a Welford
+ * running mean and variance of the hand's net result in bet units, outcome
+ * counts, a histogram of net units and the dealer bust count.
+ *
+ * Recording a hand costs a few array updates and never allocates. merge() is
+ * associative, so per-thread accumulators can be combined in any grouping.
+ */
+class OutcomeStats
+{
+public:
+    static constexpr int MinNet = -4;
+    static constexpr int MaxNet = 4;
+
+    /**
+     * @struct Cell
+     * @brief Statistics for one (total, upcard, action) decision.
+     */
+    struct Cell
+    {
+        long long count = 0;
+        double mean = 0.0;
+        double m2 = 0.0;
+        long long wins = 0;
+        long long ties = 0;
+        long long losses = 0;
+        long long dealerBusts = 0;
+        long long histogram[MaxNet - MinNet + 1] = {};
+
+        void add(double net, Outcome outcome, bool dealerBust);
+        void merge(const Cell &other);
+        double variance() const;
+    };
+
+    void record(const Hand &hand, const Card &upcard, int dealerTotal, Outcome outcome, double netUnits);
+    void merge(const OutcomeStats &other);
+
+    long long handCount() const;
+    const Cell &cell(int total, int upcard, Action action) const;
+    void report(std::ostream &os) const;
+
+private:
+    std::array<Cell, 22 * 10 * 2> cells;
+    long long hands = 0;
+
+    static int index(int total, int upcard, Action action);
+};
+
+#endif
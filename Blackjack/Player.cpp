@@ -3,6 +3,18 @@
 
 Player::Player(const std::string &name) : name(name) {}
 
+/**
+ * @brief Prepares the player for a new round.
+ *
+ * Empties the hand and clears the current bet while keeping the name and
+ * balance, so a player can be reused round after round without reallocating.
+ */
+void Player::resetForRound()
+{
+    hand.clear();
+    currentBet = 0;
+}
+
 /**
  * @brief Adds a card to the player's hand.
  *
@@ -80,11 +92,10 @@ std::string Player::getAsciiArt() const
  */
 std::string Player::getSecondCardAscii() const
 {
-    const auto &cards = hand.getCards();
-    if (cards.size() < 2)
+    if (hand.size() < 2)
         return "[Hidden]";
-    std::string val = cards[1].getDisplayValue();
-    std::string suit = cards[1].getSuitSymbol();
+    std::string val = hand[1].getDisplayValue();
+    std::string suit = hand[1].getSuitSymbol();
     std::ostringstream oss;
     oss << "┌────┐ ┌────┐\n";
     oss << "│ ?? │ │" << val << suit << "│\n";
@@ -25,6 +25,7 @@ private:
 public:
     Player(const std::string &name);
 
+    void resetForRound();
     void takeCard(const Card &c);
     bool isBusted() const;
     int handValue() const;
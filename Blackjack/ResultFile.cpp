@@ -0,0 +1,195 @@
+#include "ResultFile.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    const char Magic[4] = {'B', 'J', 'S', 'R'};
+    const std::uint16_t Version = 2;
+
+    /**
+     * Visits every integer field of a SimulationResult in file order, so the
+     * writer and the reader cannot disagree on the layout.
+     */
+    template <typename R, typename F>
+    void forEachField(R &r, F f)
+    {
+        f(r.rounds);
+        f(r.sumNet);
+        f(r.sumNetSq);
+        f(r.pairs);
+        f(r.sumPair);
+        f(r.sumPairSq);
+        for (auto &v : r.strataCount)
+            f(v);
+        for (auto &v : r.strataSum)
+            f(v);
+        for (auto &v : r.strataSumSq)
+            f(v);
+        for (auto &v : r.upcardCount)
+            f(v);
+        for (auto &v : r.upcardSum)
+            f(v);
+        f(r.dealerBusts);
+        for (auto &v : r.netHistogram)
+            f(v);
+        for (auto &v : r.totalHistogram)
+            f(v);
+    }
+
+    template <typename T>
+    void put(std::ofstream &out, T value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool get(std::ifstream &in, T &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(T)));
+    }
+}
+
+/**
+ * @brief Writes a result file.
+ *
+ * @param path Destination file, overwritten if it exists.
+ * @param file The parameters and sums to store.
+ * @return true on success, false if the file could not be written.
+ */
+bool writeResultFile(const std::string &path, const ResultFile &file)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(Magic, sizeof(Magic));
+    put<std::uint16_t>(out, Version);
+    put<std::int32_t>(out, file.numDecks);
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(file.mode));
+    put<std::uint64_t>(out, file.seed);
+    put<std::int64_t>(out, file.blockRounds);
+    put<std::uint64_t>(out, file.totalBlocks);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(file.ranges.size()));
+    for (const BlockRange &range : file.ranges)
+    {
+        put<std::uint64_t>(out, range.first);
+        put<std::uint64_t>(out, range.count);
+    }
+    forEachField(file.result, [&](long long v)
+                 { put<std::int64_t>(out, v); });
+    return static_cast<bool>(out);
+}
+
+/**
+ * @brief Reads a result file written by writeResultFile().
+ *
+ * @param path The file to read.
+ * @param file Receives the parameters and sums.
+ * @return true on success, false if the file is missing, truncated or not a result file.
+ */
+bool readResultFile(const std::string &path, ResultFile &file)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(Magic)];
+    std::uint16_t version;
+    std::int32_t decks;
+    std::uint8_t mode;
+    std::int64_t blockRounds;
+    std::uint32_t rangeCount;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+        !get(in, version) || version != Version || !get(in, decks) || !get(in, mode) ||
+        !get(in, file.seed) || !get(in, blockRounds) || !get(in, file.totalBlocks) || !get(in, rangeCount))
+        return false;
+
+    // Ranges must be sorted, disjoint and inside the run
+    file.ranges.clear();
+    std::uint64_t end = 0;
+    for (std::uint32_t i = 0; i < rangeCount; ++i)
+    {
+        BlockRange range;
+        if (!get(in, range.first) || !get(in, range.count) || range.count == 0 || range.first < end ||
+            range.count > file.totalBlocks || range.first > file.totalBlocks - range.count)
+            return false;
+        end = range.first + range.count;
+        file.ranges.push_back(range);
+    }
+
+    file.numDecks = decks;
+    file.mode = static_cast<VarianceReduction>(mode);
+    file.blockRounds = blockRounds;
+    bool ok = true;
+    forEachField(file.result, [&](long long &v)
+                 {
+                     std::int64_t x = 0;
+                     ok = ok && get(in, x);
+                     v = x; });
+    return ok;
+}
+
+/**
+ * @brief Number of blocks covered by the file.
+ */
+std::uint64_t ResultFile::blockCount() const
+{
+    std::uint64_t count = 0;
+    for (const BlockRange &range : ranges)
+        count += range.count;
+    return count;
+}
+
+/**
+ * @brief Tells whether the file covers every block of its run.
+ */
+bool ResultFile::isComplete() const
+{
+    return blockCount() == totalBlocks;
+}
+
+/**
+ * @brief Folds a shard into an accumulated result.
+ *
+ * An empty accumulator (no blocks yet) takes the shard's parameters. Otherwise
+ * the shard must come from the same run (same parameters and total blocks) and
+ * cover only blocks the accumulator does not hold yet.
+ *
+ * @param into The accumulated result.
+ * @param from The shard to add.
+ * @return true if merged, false if the shard comes from an incompatible run or overlaps.
+ */
+bool mergeResultFile(ResultFile &into, const ResultFile &from)
+{
+    if (into.ranges.empty() && into.result.rounds == 0)
+    {
+        into = from;
+        return true;
+    }
+    if (into.numDecks != from.numDecks || into.mode != from.mode || into.seed != from.seed ||
+        into.blockRounds != from.blockRounds || into.totalBlocks != from.totalBlocks)
+        return false;
+
+    std::vector<BlockRange> ranges = into.ranges;
+    ranges.insert(ranges.end(), from.ranges.begin(), from.ranges.end());
+    std::sort(ranges.begin(), ranges.end(), [](const BlockRange &a, const BlockRange &b)
+              { return a.first < b.first; });
+
+    // Reject overlaps, then coalesce adjacent ranges
+    std::vector<BlockRange> merged;
+    for (const BlockRange &range : ranges)
+    {
+        if (!merged.empty())
+        {
+            BlockRange &last = merged.back();
+            if (range.first < last.first + last.count)
+                return false;
+            if (range.first == last.first + last.count)
+            {
+                last.count += range.count;
+                continue;
+            }
+        }
+        merged.push_back(range);
+    }
+
+    into.ranges = std::move(merged);
+    into.result.merge(from.result);
+    return true;
+}
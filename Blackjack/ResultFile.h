@@ -0,0 +1,53 @@
+#ifndef RESULT_FILE_H
+#define RESULT_FILE_H
+
+#include "Simulation.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct BlockRange
+ * @brief A run of consecutive simulation blocks, [first, first + count).
+ */
+struct BlockRange
+{
+    std::uint64_t first = 0;
+    std::uint64_t count = 0;
+};
+
+/**
+ * @struct ResultFile
+ * @brief The compact binary result of a simulation run or shard.
+ *
+ * Besides the integer sums it records the parameters that define which rounds
+ * were played, so that only compatible shards are merged. Shards of one run
+ * share every parameter, including the run's total block count, and cover
+ * disjoint block ranges; merging all of them gives exactly the sums of the
+ * equivalent single run. The ranges a file covers are recorded, so merging
+ * the same shard twice, or overlapping shards, is rejected.
+ *
+ * File layout: "BJSR", u16 version, i32 decks, u8 mode, u64 seed,
+ * i64 block rounds, u64 total blocks of the run, u32 range count, then per
+ * range u64 first block and u64 block count (sorted, disjoint), then every
+ * SimulationResult field as i64.
+ */
+struct ResultFile
+{
+    int numDecks = 0;
+    VarianceReduction mode = VarianceReduction::None;
+    std::uint64_t seed = 0;
+    long long blockRounds = 0;
+    std::uint64_t totalBlocks = 0;
+    std::vector<BlockRange> ranges;
+    SimulationResult result;
+
+    std::uint64_t blockCount() const;
+    bool isComplete() const;
+};
+
+bool writeResultFile(const std::string &path, const ResultFile &file);
+bool readResultFile(const std::string &path, ResultFile &file);
+bool mergeResultFile(ResultFile &into, const ResultFile &from);
+
+#endif
@@ -0,0 +1,42 @@
+#include "Rules.h"
+
+/**
+ * @brief Decides the outcome of a hand from the final totals.
+ *
+ * A busted player always loses, even if the dealer also busts. Otherwise the
+ * player wins if the dealer busts or if the player's total is higher, and the
+ * hand is a tie when both totals are equal.
+ *
+ * @param playerScore The player's final hand value.
+ * @param dealerScore The dealer's final hand value.
+ * @return Outcome The result of the hand for the player.
+ */
+Outcome judge(int playerScore, int dealerScore)
+{
+    if (playerScore > 21)
+        return Outcome::Defeat;
+    if (dealerScore > 21 || playerScore > dealerScore)
+        return Outcome::Victory;
+    if (playerScore < dealerScore)
+        return Outcome::Defeat;
+    return Outcome::Tie;
+}
+
+/**
+ * @brief Returns the label shown to players and written to the score log.
+ *
+ * @param outcome The outcome to name.
+ * @return const char* "Victory", "Defeat" or "Tie".
+ */
+const char *outcomeName(Outcome outcome)
+{
+    switch (outcome)
+    {
+    case Outcome::Victory:
+        return "Victory";
+    case Outcome::Tie:
+        return "Tie";
+    default:
+        return "Defeat";
+    }
+}
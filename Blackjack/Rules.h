@@ -0,0 +1,20 @@
+#ifndef RULES_H
+#define RULES_H
+
+/**
+ * @enum Outcome
+ * @brief Result of a settled hand from the player's point of view.
+ *
+ * The numeric values are stable: they are stored in binary hand histories.
+ */
+enum class Outcome
+{
+    Defeat = 0,
+    Tie = 1,
+    Victory = 2
+};
+
+Outcome judge(int playerScore, int dealerScore);
+const char *outcomeName(Outcome outcome);
+
+#endif
@@ -0,0 +1,423 @@
+#include "ScoreLog.h"
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <istream>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    /**
+     * @brief Reads one record, joining the two-line form written by older versions.
+     *
+     * Older logs embedded ctime()'s trailing newline in the timestamp, so a
+     * record was split into "[date" and "] name: ...".
+     */
+    bool readRecord(std::istream &in, std::string &line)
+    {
+        if (!std::getline(in, line))
+            return false;
+        if (!line.empty() && line.front() == '[' && line.find(']') == std::string::npos)
+        {
+            std::string rest;
+            if (std::getline(in, rest))
+                line += rest;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Extracts the fields a summary needs from "[date] name: score | Dealer: ... → outcome | Solde: N tokens".
+     */
+    bool parseRecord(const std::string &line, std::string &name, Outcome &outcome, int &balance)
+    {
+        std::size_t start = line.find("] ");
+        std::size_t dealer = line.find(" | Dealer: ");
+        if (start == std::string::npos || dealer == std::string::npos || dealer < start)
+            return false;
+        std::size_t colon = line.rfind(':', dealer);
+        if (colon == std::string::npos || colon < start + 2)
+            return false;
+        name = line.substr(start + 2, colon - start - 2);
+
+        std::size_t arrow = line.find("→ ", dealer);
+        std::size_t solde = line.find(" | Solde: ", dealer);
+        if (arrow == std::string::npos || solde == std::string::npos || solde < arrow)
+            return false;
+        std::string result = line.substr(arrow + std::string("→ ").size(), solde - arrow - std::string("→ ").size());
+        if (result == outcomeName(Outcome::Victory))
+            outcome = Outcome::Victory;
+        else if (result == outcomeName(Outcome::Tie))
+            outcome = Outcome::Tie;
+        else if (result == outcomeName(Outcome::Defeat))
+            outcome = Outcome::Defeat;
+        else
+            return false;
+
+        balance = std::atoi(line.c_str() + solde + std::string(" | Solde: ").size());
+        return true;
+    }
+
+    void addRecord(std::map<std::string, ScoreSummary> &players, const std::string &line)
+    {
+        std::string name;
+        Outcome outcome;
+        int balance;
+        if (!parseRecord(line, name, outcome, balance))
+            return;
+        ScoreSummary &summary = players[name];
+        ++summary.hands;
+        switch (outcome)
+        {
+        case Outcome::Victory:
+            ++summary.wins;
+            break;
+        case Outcome::Tie:
+            ++summary.ties;
+            break;
+        case Outcome::Defeat:
+            ++summary.losses;
+            break;
+        }
+        summary.lastBalance = balance;
+    }
+
+    /**
+     * @brief Escapes a player name for the tab-separated snapshot (backslash, tab, newline).
+     */
+    std::string escapeName(const std::string &name)
+    {
+        std::string escaped;
+        escaped.reserve(name.size());
+        for (char c : name)
+        {
+            if (c == '\\')
+                escaped += "\\\\";
+            else if (c == '\t')
+                escaped += "\\t";
+            else if (c == '\n')
+                escaped += "\\n";
+            else
+                escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string unescapeName(const std::string &escaped)
+    {
+        std::string name;
+        name.reserve(escaped.size());
+        for (std::size_t i = 0; i < escaped.size(); ++i)
+        {
+            if (escaped[i] != '\\' || i + 1 == escaped.size())
+            {
+                name += escaped[i];
+                continue;
+            }
+            char c = escaped[++i];
+            name += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+        }
+        return name;
+    }
+
+    /**
+     * @brief Numbers of the sealed segments "path.N" on disk, in ascending order.
+     */
+    std::vector<std::uint64_t> listSegments(const std::string &path)
+    {
+        std::vector<std::uint64_t> segments;
+        fs::path live(path);
+        fs::path dir = live.has_parent_path() ? live.parent_path() : fs::path(".");
+        std::string prefix = live.filename().string() + ".";
+        std::error_code ec;
+        for (const auto &entry : fs::directory_iterator(dir, ec))
+        {
+            std::string file = entry.path().filename().string();
+            if (file.size() <= prefix.size() || file.compare(0, prefix.size(), prefix) != 0)
+                continue;
+            std::string suffix = file.substr(prefix.size());
+            if (std::all_of(suffix.begin(), suffix.end(), [](char c)
+                            { return c >= '0' && c <= '9'; }))
+                segments.push_back(std::stoull(suffix));
+        }
+        std::sort(segments.begin(), segments.end());
+        return segments;
+    }
+}
+
+/**
+ * @brief Opens (or creates) the live segment and starts the compaction worker.
+ *
+ * Segments left sealed by a previous run are compacted right away.
+ *
+ * @param path Live segment file; segments and the snapshot are stored next to it.
+ * @param maxBytes Size at which the live segment is sealed.
+ * @param maxAge Time after which a non-empty live segment is sealed.
+ */
+ScoreLog::ScoreLog(const std::string &path, std::uintmax_t maxBytes, std::chrono::seconds maxAge)
+    : path(path), maxBytes(maxBytes), maxAge(maxAge), liveSince(std::chrono::steady_clock::now())
+{
+    std::error_code ec;
+    liveBytes = fs::exists(path, ec) ? fs::file_size(path, ec) : 0;
+    live.open(path, std::ios::app);
+
+    std::map<std::string, ScoreSummary> ignored;
+    nextSegment = loadSummary(ignored) + 1;
+    std::vector<std::uint64_t> segments = listSegments(path);
+    if (!segments.empty())
+    {
+        nextSegment = std::max(nextSegment, segments.back() + 1);
+        pending = true;
+    }
+    compactor = std::thread(&ScoreLog::compactLoop, this);
+}
+
+ScoreLog::~ScoreLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    compactNeeded.notify_all();
+    compactor.join();
+}
+
+std::string ScoreLog::segmentPath(std::uint64_t segment) const
+{
+    return path + "." + std::to_string(segment);
+}
+
+std::string ScoreLog::summaryPath() const
+{
+    return path + ".summary";
+}
+
+/**
+ * @brief Appends one settled hand, sealing the live segment first if it is due.
+ *
+ * @param name Player name.
+ * @param playerScore Final value of the player's hand.
+ * @param dealerScore Final value of the dealer's hand.
+ * @param outcome Result of the hand.
+ * @param balance Player balance after settlement.
+ */
+void ScoreLog::append(const std::string &name, int playerScore, int dealerScore, Outcome outcome, int balance)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = std::chrono::steady_clock::now();
+    if (liveBytes >= maxBytes || (liveBytes > 0 && now - liveSince >= maxAge))
+        rotate();
+    if (liveBytes == 0)
+        liveSince = now;
+
+    std::time_t stamp = std::time(nullptr);
+    char date[32];
+    std::strftime(date, sizeof(date), "%a %b %e %H:%M:%S %Y", std::localtime(&stamp));
+
+    std::string record = "[" + std::string(date) + "] " + name + ": " + std::to_string(playerScore) +
+                         " | Dealer: " + std::to_string(dealerScore) + " → " + outcomeName(outcome) +
+                         " | Solde: " + std::to_string(balance) + " tokens\n";
+    live << record;
+    live.flush();
+    liveBytes += record.size();
+}
+
+/**
+ * @brief Seals the live segment as the next numbered segment and wakes the worker.
+ *
+ * If the rename fails, the live segment is reopened and keeps growing, and the
+ * segment number is not consumed, so sealed segments stay contiguous; the next
+ * append tries again. Called with `mutex` held.
+ */
+void ScoreLog::rotate()
+{
+    live.close();
+    std::error_code ec;
+    fs::rename(path, segmentPath(nextSegment), ec);
+    if (ec)
+    {
+        live.open(path, std::ios::app);
+        return;
+    }
+    ++nextSegment;
+    live.open(path, std::ios::trunc);
+    liveBytes = 0;
+    pending = true;
+    compactNeeded.notify_one();
+}
+
+/**
+ * @brief Worker loop: compact whenever a segment has been sealed.
+ */
+void ScoreLog::compactLoop()
+{
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            compactNeeded.wait(lock, [this]
+                               { return stopping || pending; });
+            if (stopping)
+                return;
+            pending = false;
+        }
+        compact();
+    }
+}
+
+/**
+ * @brief Folds every sealed segment into the snapshot, then deletes those segments.
+ *
+ * The new snapshot is written to a temporary file and renamed over the old
+ * one, so an interruption never loses data; at worst a segment is folded
+ * again after being skipped thanks to the recorded segment number.
+ */
+void ScoreLog::compact()
+{
+    std::lock_guard<std::mutex> lock(compactMutex);
+    std::map<std::string, ScoreSummary> players;
+    std::uint64_t last = loadSummary(players);
+    std::uint64_t first = last;
+    foldSegments(first, players, &last);
+    if (last == first)
+        return;
+
+    std::string temporary = summaryPath() + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << "# compacted-through " << last << "\n";
+        for (const auto &[name, summary] : players)
+        {
+            file << escapeName(name) << '\t' << summary.hands << '\t' << summary.wins << '\t' << summary.ties << '\t'
+                 << summary.losses << '\t' << summary.lastBalance << '\n';
+        }
+        if (!file)
+            return;
+    }
+    std::error_code ec;
+    fs::rename(temporary, summaryPath(), ec);
+    if (ec)
+        return;
+
+    for (std::uint64_t segment : listSegments(path))
+    {
+        if (segment <= last)
+            fs::remove(segmentPath(segment), ec);
+    }
+}
+
+/**
+ * @brief Loads the snapshot into @p players.
+ *
+ * @return std::uint64_t Number of the last segment folded into it (0 if none).
+ */
+std::uint64_t ScoreLog::loadSummary(std::map<std::string, ScoreSummary> &players) const
+{
+    std::ifstream file(summaryPath());
+    std::uint64_t last = 0;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.compare(0, 20, "# compacted-through ") == 0)
+        {
+            last = std::stoull(line.substr(20));
+            continue;
+        }
+        std::size_t tab = line.find('\t');
+        if (tab == std::string::npos)
+            continue;
+        ScoreSummary summary;
+        std::istringstream fields(line.substr(tab + 1));
+        if (fields >> summary.hands >> summary.wins >> summary.ties >> summary.losses >> summary.lastBalance)
+            players[unescapeName(line.substr(0, tab))] = summary;
+    }
+    return last;
+}
+
+/**
+ * @brief Adds every sealed segment numbered above @p after to @p players, oldest first.
+ *
+ * @param last If not null, receives the number of the newest segment folded.
+ */
+void ScoreLog::foldSegments(std::uint64_t after, std::map<std::string, ScoreSummary> &players,
+                            std::uint64_t *last) const
+{
+    for (std::uint64_t segment : listSegments(path))
+    {
+        if (segment <= after)
+            continue;
+        std::ifstream file(segmentPath(segment));
+        std::string line;
+        while (readRecord(file, line))
+            addRecord(players, line);
+        if (last)
+            *last = segment;
+    }
+}
+
+/**
+ * @brief Per-player totals over everything sealed so far, live segment excluded.
+ */
+std::map<std::string, ScoreSummary> ScoreLog::summary() const
+{
+    std::lock_guard<std::mutex> lock(compactMutex);
+    std::map<std::string, ScoreSummary> players;
+    foldSegments(loadSummary(players), players, nullptr);
+    return players;
+}
+
+/**
+ * @brief Deletes the live segment, every sealed segment and the snapshot.
+ */
+void ScoreLog::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> compactLock(compactMutex);
+    std::error_code ec;
+    for (std::uint64_t segment : listSegments(path))
+        fs::remove(segmentPath(segment), ec);
+    fs::remove(summaryPath(), ec);
+
+    live.close();
+    live.open(path, std::ios::trunc);
+    liveBytes = 0;
+    nextSegment = 1;
+    pending = false;
+}
+
+/**
+ * @brief Shows the per-player summary of sealed segments, then the live segment.
+ *
+ * @param out Stream receiving the report.
+ * @return bool false if nothing has been recorded at all.
+ */
+bool ScoreLog::print(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::map<std::string, ScoreSummary> players = summary();
+    std::ifstream file(path);
+    if (players.empty() && liveBytes == 0)
+        return false;
+
+    if (!players.empty())
+    {
+        out << "\n===== SCORE SUMMARY =====\n";
+        for (const auto &[name, summary] : players)
+        {
+            out << name << ": " << summary.hands << " hands | " << summary.wins << " W / " << summary.ties
+                << " T / " << summary.losses << " L | Solde: " << summary.lastBalance << " tokens\n";
+        }
+    }
+
+    out << "\n===== SCORE HISTORY =====\n";
+    std::string line;
+    while (readRecord(file, line))
+    {
+        out << line << "\n";
+    }
+    out << "=================================\n";
+    return true;
+}
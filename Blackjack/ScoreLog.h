@@ -0,0 +1,86 @@
+#ifndef SCORE_LOG_H
+#define SCORE_LOG_H
+
+#include "Rules.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @struct ScoreSummary
+ * @brief Accumulated results of one player across compacted score segments.
+ */
+struct ScoreSummary
+{
+    std::int64_t hands = 0;
+    std::int64_t wins = 0;
+    std::int64_t ties = 0;
+    std::int64_t losses = 0;
+    int lastBalance = 0;
+};
+
+/**
+ * @class ScoreLog
+ * @brief Human-readable score log with rotation and background compaction.
+ *
+ * Records are appended to a live segment (`path`). Once it grows past
+ * `maxBytes`, or has been written to for longer than `maxAge`, it is sealed
+ * as `path.N` and a new live segment is started. A worker thread then folds
+ * sealed segments into a per-player snapshot (`path.summary`) and deletes
+ * them, so the disk footprint stays bounded by the number of players.
+ *
+ * print() shows the snapshot first and then only the live segment's lines.
+ * The snapshot records the last segment it folded in, which keeps readers
+ * from counting a segment twice while compaction is catching up.
+ */
+class ScoreLog
+{
+public:
+    explicit ScoreLog(const std::string &path,
+                      std::uintmax_t maxBytes = 1 << 20,
+                      std::chrono::seconds maxAge = std::chrono::hours(24));
+    ~ScoreLog();
+
+    ScoreLog(const ScoreLog &) = delete;
+    ScoreLog &operator=(const ScoreLog &) = delete;
+
+    void append(const std::string &name, int playerScore, int dealerScore, Outcome outcome, int balance);
+    void clear();
+    bool print(std::ostream &out) const;
+    std::map<std::string, ScoreSummary> summary() const;
+
+private:
+    std::string path;
+    std::uintmax_t maxBytes;
+    std::chrono::seconds maxAge;
+
+    std::ofstream live;
+    std::uintmax_t liveBytes = 0;
+    std::chrono::steady_clock::time_point liveSince;
+    std::uint64_t nextSegment = 1;
+    mutable std::mutex mutex;
+
+    // Held while the snapshot and the sealed segments change
+    mutable std::mutex compactMutex;
+    std::condition_variable compactNeeded;
+    bool pending = false;
+    bool stopping = false;
+    std::thread compactor;
+
+    std::string segmentPath(std::uint64_t segment) const;
+    std::string summaryPath() const;
+    void rotate();
+    void compactLoop();
+    void compact();
+    std::uint64_t loadSummary(std::map<std::string, ScoreSummary> &players) const;
+    void foldSegments(std::uint64_t after, std::map<std::string, ScoreSummary> &players,
+                      std::uint64_t *last) const;
+};
+
+#endif
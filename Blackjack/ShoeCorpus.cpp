@@ -0,0 +1,113 @@
+#include "ShoeCorpus.h"
+#include "Card.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    const char Magic[4] = {'B', 'J', 'S', 'C'};
+    const std::uint16_t Version = 1;
+    const std::size_t HeaderSize = 16;
+}
+
+/**
+ * @brief Maps a corpus file and validates its header and cards.
+ *
+ * A file whose shoe count does not fit its size, or that holds a byte
+ * Card::fromByte() cannot decode, is rejected.
+ *
+ * @param path Location of the corpus. Use isOpen() to check it was mapped.
+ */
+ShoeCorpus::ShoeCorpus(const std::string &path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= HeaderSize)
+    {
+        void *p = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        if (p != MAP_FAILED)
+        {
+            data = static_cast<const std::uint8_t *>(p);
+            length = static_cast<std::size_t>(info.st_size);
+        }
+    }
+    ::close(fd);
+    if (!data)
+        return;
+
+    std::uint16_t version, decks;
+    std::uint64_t shoes;
+    std::memcpy(&version, data + 4, sizeof(version));
+    std::memcpy(&decks, data + 6, sizeof(decks));
+    std::memcpy(&shoes, data + 8, sizeof(shoes));
+    // Divide rather than multiply so a corrupt shoe count cannot wrap the size check
+    bool valid = std::memcmp(data, Magic, sizeof(Magic)) == 0 && version == Version && decks != 0 &&
+                 shoes <= (length - HeaderSize) / (52u * decks);
+    for (std::size_t i = HeaderSize; valid && i < HeaderSize + shoes * 52u * decks; ++i)
+        valid = Card::isValidByte(data[i]);
+    if (!valid)
+    {
+        ::munmap(const_cast<std::uint8_t *>(data), length);
+        data = nullptr;
+        return;
+    }
+    numDecks = decks;
+    shoeCount = static_cast<std::size_t>(shoes);
+}
+
+ShoeCorpus::~ShoeCorpus()
+{
+    if (data)
+        ::munmap(const_cast<std::uint8_t *>(data), length);
+}
+
+bool ShoeCorpus::isOpen() const
+{
+    return data != nullptr;
+}
+
+std::size_t ShoeCorpus::size() const
+{
+    return shoeCount;
+}
+
+int ShoeCorpus::getNumDecks() const
+{
+    return numDecks;
+}
+
+const std::uint8_t *ShoeCorpus::shoe(std::size_t index) const
+{
+    return data + HeaderSize + index * cardsPerShoe();
+}
+
+/**
+ * @brief Writes every shoe of @p shoes to a corpus file.
+ *
+ * @param path Destination file, overwritten if it exists.
+ * @param shoes The shoes to store, e.g. a freshly generated ShoeSet.
+ * @return true on success, false if the file could not be written.
+ */
+bool ShoeCorpus::write(const std::string &path, const ShoeSource &shoes)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    std::uint16_t version = Version;
+    std::uint16_t decks = static_cast<std::uint16_t>(shoes.getNumDecks());
+    std::uint64_t count = shoes.size();
+    out.write(Magic, sizeof(Magic));
+    out.write(reinterpret_cast<const char *>(&version), sizeof(version));
+    out.write(reinterpret_cast<const char *>(&decks), sizeof(decks));
+    out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+    for (std::size_t i = 0; i < shoes.size(); ++i)
+    {
+        out.write(reinterpret_cast<const char *>(shoes.shoe(i)), static_cast<std::streamsize>(shoes.cardsPerShoe()));
+    }
+    return static_cast<bool>(out);
+}
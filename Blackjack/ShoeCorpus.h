@@ -0,0 +1,41 @@
+#ifndef SHOE_CORPUS_H
+#define SHOE_CORPUS_H
+
+#include "ShoeSet.h"
+#include <string>
+
+/**
+ * @class ShoeCorpus
+ * @brief A file of pre-shuffled shoes, memory-mapped for zero-copy dealing.
+ *
+ * Benchmarks and strategy comparisons that read the same corpus see exactly
+ * the same cards, and pay no random number generation in the measured loop:
+ * Deck::attach() deals straight from the mapped bytes.
+ *
+ * File layout: "BJSC", u16 version, u16 decks per shoe, u64 shoe count,
+ * then every shoe's Card::toByte() bytes back to back (16-byte header).
+ */
+class ShoeCorpus : public ShoeSource
+{
+public:
+    explicit ShoeCorpus(const std::string &path);
+    ~ShoeCorpus() override;
+
+    ShoeCorpus(const ShoeCorpus &) = delete;
+    ShoeCorpus &operator=(const ShoeCorpus &) = delete;
+
+    bool isOpen() const;
+    std::size_t size() const override;
+    int getNumDecks() const override;
+    const std::uint8_t *shoe(std::size_t index) const override;
+
+    static bool write(const std::string &path, const ShoeSource &shoes);
+
+private:
+    const std::uint8_t *data = nullptr;
+    std::size_t length = 0;
+    std::size_t shoeCount = 0;
+    int numDecks = 0;
+};
+
+#endif
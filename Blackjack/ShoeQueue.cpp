@@ -0,0 +1,88 @@
+#include "ShoeQueue.h"
+#include <algorithm>
+
+/**
+ * @brief Starts the producer thread.
+ *
+ * @param numDecks Number of 52-card packs per shoe.
+ * @param depth Maximum number of shuffled shoes kept waiting (at least 1).
+ */
+ShoeQueue::ShoeQueue(int numDecks, std::size_t depth)
+    : numDecks(numDecks), ready(std::max<std::size_t>(depth, 1)), rng(std::random_device{}())
+{
+    spare.reserve(ready.size() + 2);
+    producer = std::thread(&ShoeQueue::produce, this);
+}
+
+ShoeQueue::~ShoeQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    notFull.notify_all();
+    producer.join();
+}
+
+/**
+ * @brief Replaces the deck's cards with the next shuffled shoe.
+ *
+ * Blocks only if the producer has fallen behind and no shoe is ready.
+ *
+ * @param deck The deck receiving the shoe. Its previous cards are recycled.
+ */
+void ShoeQueue::next(Deck &deck)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this]
+                  { return count > 0; });
+
+    std::vector<Card> &shoe = ready[head];
+    deck.exchange(shoe);
+    spare.push_back(std::move(shoe));
+    head = (head + 1) % ready.size();
+    --count;
+
+    lock.unlock();
+    notFull.notify_one();
+}
+
+/**
+ * @brief Producer loop: refill recycled storage, shuffle, publish.
+ *
+ * The shuffle runs outside the lock, so consumers are never held up by it.
+ */
+void ShoeQueue::produce()
+{
+    std::vector<Card> shoe;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this]
+                         { return stopping || count < ready.size(); });
+            if (stopping)
+                return;
+            if (!spare.empty())
+            {
+                shoe = std::move(spare.back());
+                spare.pop_back();
+            }
+        }
+
+        shoe.clear();
+        shoe.reserve(static_cast<std::size_t>(52) * numDecks);
+        for (int d = 0; d < numDecks; ++d)
+            for (int s = 0; s < 4; ++s)
+                for (int r = 1; r <= 13; ++r)
+                    shoe.emplace_back(r, static_cast<Suit>(s));
+        std::shuffle(shoe.begin(), shoe.end(), rng);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[(head + count) % ready.size()] = std::move(shoe);
+            ++count;
+        }
+        notEmpty.notify_one();
+    }
+}
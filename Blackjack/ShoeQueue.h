@@ -0,0 +1,49 @@
+#ifndef SHOE_QUEUE_H
+#define SHOE_QUEUE_H
+
+#include "Card.h"
+#include "Deck.h"
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ShoeQueue
+ * @brief Background producer of ready-shuffled shoes.
+ *
+ * A worker thread keeps up to `depth` shuffled shoes waiting, so a round can
+ * start on a fresh shoe without paying for the shuffle. next() swaps a ready
+ * shoe into a Deck in O(1) and hands the deck's previous storage back to the
+ * producer for refilling, so steady-state operation does not allocate.
+ */
+class ShoeQueue
+{
+public:
+    ShoeQueue(int numDecks, std::size_t depth);
+    ~ShoeQueue();
+
+    ShoeQueue(const ShoeQueue &) = delete;
+    ShoeQueue &operator=(const ShoeQueue &) = delete;
+
+    void next(Deck &deck);
+
+private:
+    int numDecks;
+    std::vector<std::vector<Card>> ready;
+    std::size_t head = 0;
+    std::size_t count = 0;
+    std::vector<std::vector<Card>> spare;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+    bool stopping = false;
+    std::mt19937 rng;
+    std::thread producer;
+
+    void produce();
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "ShoeSet.h"
+#include "Card.h"
+#include <algorithm>
+#include <random>
+
+/**
+ * @brief Derives an independent seed for stream @p index from a base seed.
+ *
+ * Uses the SplitMix64 finalizer, so neighbouring indices give unrelated seeds.
+ *
+ * @param seed The base seed of a run.
+ * @param index The stream (shoe, round, shard...) the seed is for.
+ * @return std::uint64_t The derived seed.
+ */
+std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t index)
+{
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (index + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Generates @p shoes shuffled shoes of @p numDecks decks each.
+ *
+ * @param shoes Number of shoes to generate.
+ * @param numDecks Number of 52-card packs per shoe.
+ * @param seed Base seed; shoe i is shuffled with deriveSeed(seed, i).
+ */
+ShoeSet::ShoeSet(std::size_t shoes, int numDecks, std::uint64_t seed)
+    : numDecks(numDecks), shoeCount(shoes), cards(shoes * 52 * numDecks)
+{
+    const std::size_t perShoe = static_cast<std::size_t>(52) * numDecks;
+    for (std::size_t i = 0; i < shoes; ++i)
+    {
+        std::uint8_t *shoe = cards.data() + i * perShoe;
+        std::size_t n = 0;
+        for (int d = 0; d < numDecks; ++d)
+            for (int s = 0; s < 4; ++s)
+                for (int r = 1; r <= 13; ++r)
+                    shoe[n++] = Card(r, static_cast<Suit>(s)).toByte();
+
+        std::mt19937_64 rng(deriveSeed(seed, i));
+        std::shuffle(shoe, shoe + perShoe, rng);
+    }
+}
+
+std::size_t ShoeSet::size() const
+{
+    return shoeCount;
+}
+
+int ShoeSet::getNumDecks() const
+{
+    return numDecks;
+}
+
+std::size_t ShoeSource::cardsPerShoe() const
+{
+    return static_cast<std::size_t>(52) * getNumDecks();
+}
+
+const std::uint8_t *ShoeSet::shoe(std::size_t index) const
+{
+    return cards.data() + index * cardsPerShoe();
+}
@@ -0,0 +1,52 @@
+#ifndef SHOE_SET_H
+#define SHOE_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class ShoeSource
+ * @brief Read-only collection of shoes stored as Card::toByte() bytes.
+ *
+ * Each shoe is laid out in the order Deck::assign() and Deck::attach()
+ * expect, i.e. the last byte is dealt first.
+ */
+class ShoeSource
+{
+public:
+    virtual ~ShoeSource() = default;
+
+    virtual std::size_t size() const = 0;
+    virtual int getNumDecks() const = 0;
+    virtual const std::uint8_t *shoe(std::size_t index) const = 0;
+    std::size_t cardsPerShoe() const;
+};
+
+/**
+ * @class ShoeSet
+ * @brief A reproducible set of pre-shuffled shoes.
+ *
+ * Every shoe is stored as Card::toByte() bytes in the order Deck::assign()
+ * expects. Shoe i depends only on the seed and on i, so the same set can be
+ * regenerated anywhere and every candidate evaluated on it sees identical cards
+ * (common random numbers).
+ */
+class ShoeSet : public ShoeSource
+{
+public:
+    ShoeSet(std::size_t shoes, int numDecks, std::uint64_t seed);
+
+    std::size_t size() const override;
+    int getNumDecks() const override;
+    const std::uint8_t *shoe(std::size_t index) const override;
+
+private:
+    int numDecks;
+    std::size_t shoeCount;
+    std::vector<std::uint8_t> cards;
+};
+
+std::uint64_t deriveSeed(std::uint64_t seed, std::uint64_t index);
+
+#endif
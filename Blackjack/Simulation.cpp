@@ -0,0 +1,384 @@
+#include "Simulation.h"
+#include "ShoeSet.h"
+#include "Table.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <string>
+
+namespace
+{
+    const double Z95 = 1.959963984540054;
+
+    /** Index of the unordered pair of card values (a, b), 1 <= a, b <= 10. */
+    int stratumOf(int a, int b)
+    {
+        if (a > b)
+            std::swap(a, b);
+        return (a - 1) * 10 - (a - 1) * (a - 2) / 2 + (b - a);
+    }
+
+    /** Probability of each card value (1..10) in a fresh shoe. */
+    double valueProbability(int value)
+    {
+        return value == 10 ? 4.0 / 13.0 : 1.0 / 13.0;
+    }
+
+    /**
+     * Exact probability of each first-two-card stratum for the first player of a
+     * fresh shoe of @p numDecks decks (cards are exchangeable, so only the
+     * composition matters).
+     */
+    void strataProbabilities(int numDecks, double *p)
+    {
+        std::fill(p, p + SimulationResult::Strata, 0.0);
+        double n = 52.0 * numDecks;
+        for (int a = 1; a <= 10; ++a)
+        {
+            for (int b = 1; b <= 10; ++b)
+            {
+                double na = (a == 10 ? 16.0 : 4.0) * numDecks;
+                double nb = (b == 10 ? 16.0 : 4.0) * numDecks - (a == b ? 1 : 0);
+                p[stratumOf(a, b)] += na * nb / (n * (n - 1));
+            }
+        }
+    }
+
+    /**
+     * Probability that a dealer standing on all 17s busts from (total, soft),
+     * drawing from an infinite shoe.
+     */
+    double bustFrom(int total, bool soft)
+    {
+        if (total > 21 && soft)
+        {
+            total -= 10;
+            soft = false;
+        }
+        if (total > 21)
+            return 1.0;
+        if (total >= 17)
+            return 0.0;
+
+        double p = 0.0;
+        for (int v = 1; v <= 10; ++v)
+        {
+            if (v == 1 && total + 11 <= 21)
+                p += valueProbability(v) * bustFrom(total + 11, true);
+            else
+                p += valueProbability(v) * bustFrom(total + v, soft);
+        }
+        return p;
+    }
+
+    /**
+     * Infinite-shoe dealer bust rate for each upcard value (index value - 1).
+     * Built once by a function-local static, so concurrent estimates are safe.
+     */
+    const double *dealerBustRates()
+    {
+        static const std::array<double, 10> rates = []
+        {
+            std::array<double, 10> table{};
+            for (int up = 1; up <= 10; ++up)
+                table[up - 1] = up == 1 ? bustFrom(11, true) : bustFrom(up, false);
+            return table;
+        }();
+        return rates.data();
+    }
+}
+
+/**
+ * @brief Adds another result's sums to this one.
+ *
+ * @param other The result to fold in.
+ */
+void SimulationResult::merge(const SimulationResult &other)
+{
+    rounds += other.rounds;
+    sumNet += other.sumNet;
+    sumNetSq += other.sumNetSq;
+    pairs += other.pairs;
+    sumPair += other.sumPair;
+    sumPairSq += other.sumPairSq;
+    for (int s = 0; s < Strata; ++s)
+    {
+        strataCount[s] += other.strataCount[s];
+        strataSum[s] += other.strataSum[s];
+        strataSumSq[s] += other.strataSumSq[s];
+    }
+    for (int u = 0; u < Upcards; ++u)
+    {
+        upcardCount[u] += other.upcardCount[u];
+        upcardSum[u] += other.upcardSum[u];
+    }
+    dealerBusts += other.dealerBusts;
+    for (int i = 0; i < 3; ++i)
+        netHistogram[i] += other.netHistogram[i];
+    for (int t = 0; t < Totals; ++t)
+        totalHistogram[t] += other.totalHistogram[t];
+}
+
+/**
+ * @brief Computes the house edge and its standard error from collected sums.
+ *
+ * The house edge is the player's expected loss per unit wagered. Estimators
+ * that cannot be evaluated yet (too few samples, empty strata) report an
+ * infinite standard error.
+ *
+ * @param result The collected sums.
+ * @param mode The estimator to use.
+ * @param numDecks Number of decks per shoe, needed for exact stratum weights.
+ * @return Estimate The house edge and its standard error.
+ */
+Estimate estimate(const SimulationResult &result, VarianceReduction mode, int numDecks)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double n = static_cast<double>(result.rounds);
+    if (result.rounds < 2)
+        return {0.0, inf};
+
+    double mean = result.sumNet / n;
+    double variance = (result.sumNetSq - n * mean * mean) / (n - 1);
+
+    switch (mode)
+    {
+    case VarianceReduction::Antithetic:
+    {
+        if (result.pairs < 2)
+            return {-mean, inf};
+        double m = static_cast<double>(result.pairs);
+        double pairMean = result.sumPair / (2.0 * m);
+        double pairVariance = (result.sumPairSq / 4.0 - m * pairMean * pairMean) / (m - 1);
+        return {-pairMean, std::sqrt(pairVariance / m)};
+    }
+    case VarianceReduction::Stratified:
+    {
+        double weight[SimulationResult::Strata];
+        strataProbabilities(numDecks, weight);
+        double edge = 0.0, var = 0.0;
+        for (int s = 0; s < SimulationResult::Strata; ++s)
+        {
+            double k = static_cast<double>(result.strataCount[s]);
+            if (k < 2)
+                return {-mean, inf};
+            double m = result.strataSum[s] / k;
+            double v = (result.strataSumSq[s] - k * m * m) / (k - 1);
+            edge -= weight[s] * m;
+            var += weight[s] * weight[s] * v / k;
+        }
+        return {edge, std::sqrt(var)};
+    }
+    case VarianceReduction::ControlVariate:
+    {
+        const double *bust = dealerBustRates();
+        double expected = 0.0, sumC = 0.0, sumCC = 0.0, sumXC = 0.0;
+        for (int u = 0; u < SimulationResult::Upcards; ++u)
+        {
+            expected += valueProbability(u + 1) * bust[u];
+            sumC += result.upcardCount[u] * bust[u];
+            sumCC += result.upcardCount[u] * bust[u] * bust[u];
+            sumXC += result.upcardSum[u] * bust[u];
+        }
+        double meanC = sumC / n;
+        double varC = (sumCC - n * meanC * meanC) / (n - 1);
+        double cov = (sumXC - n * mean * meanC) / (n - 1);
+        if (varC <= 0.0)
+            return {-mean, inf};
+        double beta = cov / varC;
+        double adjusted = mean - beta * (meanC - expected);
+        double residual = std::max(0.0, variance - cov * cov / varC);
+        return {-adjusted, std::sqrt(residual / n)};
+    }
+    default:
+        return {-mean, std::sqrt(variance / n)};
+    }
+}
+
+const char *varianceReductionName(VarianceReduction mode)
+{
+    switch (mode)
+    {
+    case VarianceReduction::Antithetic:
+        return "antithetic";
+    case VarianceReduction::Stratified:
+        return "stratified";
+    case VarianceReduction::ControlVariate:
+        return "control";
+    default:
+        return "none";
+    }
+}
+
+/**
+ * @brief Parses a mode name as printed by varianceReductionName().
+ *
+ * @return true if @p name is a known mode, false otherwise.
+ */
+bool parseVarianceReduction(const std::string &name, VarianceReduction &mode)
+{
+    for (VarianceReduction m : {VarianceReduction::None, VarianceReduction::Antithetic,
+                                VarianceReduction::Stratified, VarianceReduction::ControlVariate})
+    {
+        if (name == varianceReductionName(m))
+        {
+            mode = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param config Parameters of the run.
+ * @param strategy Playing decisions of the simulated player.
+ * @param pool Threads used to play blocks in parallel.
+ */
+Simulation::Simulation(const SimulationConfig &config, const Strategy &strategy, ThreadPool &pool)
+    : config(config), strategy(strategy), pool(pool)
+{
+    if (this->config.blockRounds % 2)
+        ++this->config.blockRounds;
+}
+
+/**
+ * @brief Plays one block of rounds, each on a freshly shuffled shoe.
+ *
+ * Shoes are dealt lazily. In antithetic mode the deck is reseeded for every
+ * pair of rounds and the second round mirrors the first one's picks.
+ * When @p stats is given, every hand is also recorded in it.
+ */
+void Simulation::playBlock(std::uint64_t block, SimulationResult &result, OutcomeStats *stats) const
+{
+    const bool antithetic = config.mode == VarianceReduction::Antithetic;
+    std::uint64_t blockSeed = deriveSeed(config.seed, block);
+
+    Deck deck(config.numDecks);
+    deck.setLazyShuffle(true);
+    deck.seed(static_cast<std::uint32_t>(blockSeed));
+    Table table;
+    Player player("Simulated");
+
+    int pairNet = 0;
+    for (long long r = 0; r < config.blockRounds; ++r)
+    {
+        if (antithetic)
+        {
+            if (r % 2 == 0)
+                deck.seed(static_cast<std::uint32_t>(deriveSeed(blockSeed, static_cast<std::uint64_t>(r))));
+            else
+                deck.seed(static_cast<std::uint32_t>(deriveSeed(blockSeed, static_cast<std::uint64_t>(r - 1))));
+            deck.setAntithetic(r % 2 == 1);
+        }
+        deck.reset();
+
+        int before = player.getBalance();
+        Outcome outcome = table.playRound(deck, player, 1, strategy);
+        int net = player.getBalance() - before;
+
+        const Hand &hand = player.getHand();
+        const Hand &dealerHand = table.getDealer().getHand();
+        int stratum = stratumOf(upcardValue(hand[0]), upcardValue(hand[1]));
+        int upcard = upcardValue(dealerHand[1]) - 1;
+
+        ++result.rounds;
+        result.sumNet += net;
+        result.sumNetSq += net * net;
+        ++result.strataCount[stratum];
+        result.strataSum[stratum] += net;
+        result.strataSumSq[stratum] += net * net;
+        ++result.upcardCount[upcard];
+        result.upcardSum[upcard] += net;
+        if (dealerHand.value() > 21)
+            ++result.dealerBusts;
+        ++result.netHistogram[net + 1];
+        ++result.totalHistogram[std::min(hand.value(), SimulationResult::Totals - 1)];
+        if (stats)
+            stats->record(hand, dealerHand[1], dealerHand.value(), outcome, net);
+
+        if (antithetic)
+        {
+            pairNet += net;
+            if (r % 2 == 1)
+            {
+                ++result.pairs;
+                result.sumPair += pairNet;
+                result.sumPairSq += pairNet * pairNet;
+                pairNet = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Plays blocks [firstBlock, firstBlock + count) in parallel.
+ *
+ * @param stats Optional accumulator receiving every hand. Each block fills its
+ *              own accumulator, which is then merged into @p stats.
+ * @return SimulationResult The merged sums of every block.
+ */
+SimulationResult Simulation::runBlocks(std::uint64_t firstBlock, std::uint64_t count, OutcomeStats *stats)
+{
+    std::vector<SimulationResult> partial(count);
+    std::mutex statsMutex;
+    pool.run(count, [&](std::size_t i)
+             {
+                 if (!stats)
+                 {
+                     playBlock(firstBlock + i, partial[i], nullptr);
+                     return;
+                 }
+                 OutcomeStats local;
+                 playBlock(firstBlock + i, partial[i], &local);
+                 std::lock_guard<std::mutex> lock(statsMutex);
+                 stats->merge(local); });
+
+    SimulationResult total;
+    for (const SimulationResult &r : partial)
+        total.merge(r);
+    return total;
+}
+
+/**
+ * @brief Runs until the confidence interval is narrow enough or maxRounds is reached.
+ *
+ * After each batch of blocks the running house edge and standard error are
+ * written to @p log.
+ *
+ * @param log Stream receiving progress lines.
+ * @param stats Optional accumulator receiving every hand.
+ * @return SimulationResult The sums of every round played.
+ */
+SimulationResult Simulation::run(std::ostream &log, OutcomeStats *stats)
+{
+    const std::uint64_t batch = std::max<std::uint64_t>(pool.size() * 4, 1);
+    const std::uint64_t maxBlocks = static_cast<std::uint64_t>(
+        (config.maxRounds + config.blockRounds - 1) / config.blockRounds);
+
+    SimulationResult total;
+    std::uint64_t block = 0;
+    while (block < maxBlocks)
+    {
+        std::uint64_t count = std::min(batch, maxBlocks - block);
+        total.merge(runBlocks(block, count, stats));
+        block += count;
+
+        Estimate e = estimate(total);
+        log << total.rounds << " rounds: house edge " << e.houseEdge * 100 << "% ± " << e.standardError * 100 << "%\n";
+        if (config.ciWidth > 0 && 2 * Z95 * e.standardError <= config.ciWidth)
+            break;
+    }
+    return total;
+}
+
+Estimate Simulation::estimate(const SimulationResult &result) const
+{
+    return ::estimate(result, config.mode, config.numDecks);
+}
+
+const SimulationConfig &Simulation::getConfig() const
+{
+    return config;
+}
@@ -0,0 +1,126 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "OutcomeStats.h"
+#include "Strategy.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @enum VarianceReduction
+ * @brief How a simulation estimates the house edge.
+ *
+ * - None: plain mean of the net result per round.
+ * - Antithetic: rounds are played in pairs whose shuffles mirror each other,
+ *   and the pair averages are used as samples.
+ * - Stratified: post-stratification on the player's first two card values,
+ *   weighted by their exact probabilities in a fresh shoe.
+ * - ControlVariate: regression on the dealer bust rate of the upcard, whose
+ *   expectation over a fresh shoe is known exactly.
+ */
+enum class VarianceReduction
+{
+    None,
+    Antithetic,
+    Stratified,
+    ControlVariate
+};
+
+/**
+ * @struct SimulationResult
+ * @brief Integer sums collected by a simulation, enough for every estimator.
+ *
+ * All fields are counts or integer sums of the net result of 1-unit rounds,
+ * so results from independent runs merge exactly, in any order.
+ */
+struct SimulationResult
+{
+    static constexpr int Strata = 55;
+    static constexpr int Upcards = 10;
+    static constexpr int Totals = 32;
+
+    long long rounds = 0;
+    long long sumNet = 0;
+    long long sumNetSq = 0;
+
+    long long pairs = 0;
+    long long sumPair = 0;
+    long long sumPairSq = 0;
+
+    long long strataCount[Strata] = {};
+    long long strataSum[Strata] = {};
+    long long strataSumSq[Strata] = {};
+
+    long long upcardCount[Upcards] = {};
+    long long upcardSum[Upcards] = {};
+
+    long long dealerBusts = 0;
+    long long netHistogram[3] = {};
+    long long totalHistogram[Totals] = {};
+
+    void merge(const SimulationResult &other);
+};
+
+/**
+ * @struct Estimate
+ * @brief A house-edge estimate and its standard error, both per unit wagered.
+ */
+struct Estimate
+{
+    double houseEdge;
+    double standardError;
+};
+
+/**
+ * @struct SimulationConfig
+ * @brief Parameters of a simulation run.
+ *
+ * Rounds are played in blocks of blockRounds. Block b always uses the seed
+ * deriveSeed(seed, b), so a run is reproducible whatever the thread count.
+ * ciWidth is the full width of the 95% confidence interval at which the run
+ * stops; 0 disables the stopping rule and plays maxRounds.
+ */
+struct SimulationConfig
+{
+    int numDecks = 6;
+    std::uint64_t seed = 1;
+    VarianceReduction mode = VarianceReduction::None;
+    double ciWidth = 0.0;
+    long long maxRounds = 10000000;
+    long long blockRounds = 4096;
+};
+
+/**
+ * @class Simulation
+ * @brief Monte Carlo estimate of the house edge of the Game round.
+ *
+ * Every round is played headlessly on a freshly shuffled shoe, exactly like
+ * Game::playRound, with one player betting one unit and following a Strategy.
+ * The run reports a running estimate with its standard error and can stop as
+ * soon as the requested confidence-interval width is reached.
+ */
+class Simulation
+{
+public:
+    Simulation(const SimulationConfig &config, const Strategy &strategy, ThreadPool &pool);
+
+    SimulationResult runBlocks(std::uint64_t firstBlock, std::uint64_t count, OutcomeStats *stats = nullptr);
+    SimulationResult run(std::ostream &log, OutcomeStats *stats = nullptr);
+    Estimate estimate(const SimulationResult &result) const;
+    const SimulationConfig &getConfig() const;
+
+private:
+    SimulationConfig config;
+    const Strategy &strategy;
+    ThreadPool &pool;
+
+    void playBlock(std::uint64_t block, SimulationResult &result, OutcomeStats *stats) const;
+};
+
+Estimate estimate(const SimulationResult &result, VarianceReduction mode, int numDecks);
+const char *varianceReductionName(VarianceReduction mode);
+bool parseVarianceReduction(const std::string &name, VarianceReduction &mode);
+
+#endif
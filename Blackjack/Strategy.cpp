@@ -0,0 +1,127 @@
+#include "Strategy.h"
+#include <algorithm>
+#include <iomanip>
+
+/**
+ * @brief Blackjack value of a dealer upcard: 1 for an ace, 10 for any face card.
+ */
+int upcardValue(const Card &card)
+{
+    return std::min(card.getRank(), 10);
+}
+
+/**
+ * @brief Hi-Lo counting tag of a card: +1 for 2–6, 0 for 7–9, -1 for tens and aces.
+ */
+int hiLoValue(const Card &card)
+{
+    int v = upcardValue(card);
+    if (v >= 2 && v <= 6)
+        return 1;
+    if (v == 1 || v == 10)
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Creates a strategy that always stands and flat-bets one unit.
+ */
+Strategy::Strategy()
+{
+    for (auto &row : hardHit)
+        row.fill(false);
+    for (auto &row : softHit)
+        row.fill(false);
+    betRamp.fill(1);
+}
+
+/**
+ * @brief Returns basic strategy for this game's rules.
+ *
+ * The dealer stands on all 17s and players may only hit or stand, so the
+ * tables reduce to: hard 12 stands against 4–6, hard 13–16 stand against 2–6,
+ * hard 17+ always stands, soft 18 stands against 2–8 and soft 19+ always
+ * stands. Everything lower hits. Bets are flat.
+ *
+ * @return Strategy The basic strategy tables.
+ */
+Strategy Strategy::basic()
+{
+    Strategy s;
+    for (int up = 1; up <= 10; ++up)
+    {
+        bool weak = up >= 2 && up <= 6;
+        for (int total = 0; total <= 21; ++total)
+        {
+            bool hardHits = total <= 11 || (total == 12 && !(up >= 4 && up <= 6)) || (total <= 16 && total >= 13 && !weak);
+            bool softHits = total <= 17 || (total == 18 && (up == 1 || up >= 9));
+            s.setHit(false, total, up, hardHits);
+            s.setHit(true, total, up, softHits);
+        }
+    }
+    return s;
+}
+
+/**
+ * @brief Chooses the action for a hand against the dealer's upcard.
+ *
+ * @param hand The player's current hand.
+ * @param upcard The dealer's visible card.
+ * @return Action Hit or Stand.
+ */
+Action Strategy::decide(const Hand &hand, const Card &upcard) const
+{
+    int total = hand.value();
+    if (total >= 21)
+        return Action::Stand;
+    return getHit(hand.isSoft(), total, upcardValue(upcard)) ? Action::Hit : Action::Stand;
+}
+
+bool Strategy::getHit(bool soft, int total, int upcard) const
+{
+    return soft ? softHit[total][upcard] : hardHit[total][upcard];
+}
+
+void Strategy::setHit(bool soft, int total, int upcard, bool hit)
+{
+    (soft ? softHit : hardHit)[total][upcard] = hit;
+}
+
+/**
+ * @brief Bet in units for a Hi-Lo true count, clamped to the ramp's range.
+ */
+int Strategy::betUnits(int trueCount) const
+{
+    return betRamp[std::clamp(trueCount, MinCount, MaxCount) - MinCount];
+}
+
+void Strategy::setBetUnits(int trueCount, int units)
+{
+    betRamp[std::clamp(trueCount, MinCount, MaxCount) - MinCount] = units;
+}
+
+/**
+ * @brief Prints the playing tables (H = hit, S = stand) and the bet ramp.
+ *
+ * @param os The stream to print to.
+ */
+void Strategy::print(std::ostream &os) const
+{
+    for (int soft = 0; soft <= 1; ++soft)
+    {
+        os << (soft ? "Soft" : "Hard") << "   2 3 4 5 6 7 8 9 T A\n";
+        for (int total = soft ? 13 : 5; total <= 20; ++total)
+        {
+            os << std::setw(4) << total << "  ";
+            for (int i = 0; i < 10; ++i)
+            {
+                int up = i == 9 ? 1 : i + 2;
+                os << ' ' << (getHit(soft, total, up) ? 'H' : 'S');
+            }
+            os << "\n";
+        }
+    }
+    os << "Bet ramp (true count: units)\n";
+    for (int tc = MinCount; tc <= MaxCount; ++tc)
+        os << "  " << std::showpos << tc << std::noshowpos << ": " << betUnits(tc) << "\n";
+}
@@ -0,0 +1,53 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+#include "Hand.h"
+#include <array>
+#include <ostream>
+
+/**
+ * @enum Action
+ * @brief A playing decision. The game only offers hit and stand.
+ */
+enum class Action
+{
+    Hit,
+    Stand
+};
+
+/**
+ * @class Strategy
+ * @brief Playing and betting tables used by automated players.
+ *
+ * The playing tables hold a hit/stand decision for every hard and soft total
+ * against every dealer upcard (1 = ace, 10 = any ten-value card). The bet ramp
+ * gives the bet, in units, for each Hi-Lo true count from MinCount to MaxCount.
+ */
+class Strategy
+{
+public:
+    static constexpr int MinCount = -5;
+    static constexpr int MaxCount = 5;
+
+    Strategy();
+    static Strategy basic();
+
+    Action decide(const Hand &hand, const Card &upcard) const;
+    bool getHit(bool soft, int total, int upcard) const;
+    void setHit(bool soft, int total, int upcard, bool hit);
+
+    int betUnits(int trueCount) const;
+    void setBetUnits(int trueCount, int units);
+
+    void print(std::ostream &os) const;
+
+private:
+    std::array<std::array<bool, 11>, 22> hardHit;
+    std::array<std::array<bool, 11>, 22> softHit;
+    std::array<int, MaxCount - MinCount + 1> betRamp;
+};
+
+int upcardValue(const Card &card);
+int hiLoValue(const Card &card);
+
+#endif
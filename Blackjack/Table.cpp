@@ -0,0 +1,99 @@
+#include "Table.h"
+#include "AllocStats.h"
+
+Table::Table() : dealer("Dealer") {}
+
+/**
+ * @brief Plays and settles one round for a single player.
+ *
+ * The player's hand and bet are reset first, so the same Player can be reused
+ * for every round; the balance carries over and reflects the settlement.
+ *
+ * @param deck The deck or shoe to deal from. It must hold enough cards for a round.
+ * @param player The player taking part in the round.
+ * @param bet The amount wagered.
+ * @param strategy The playing decisions used for the player.
+ * @return Outcome The result of the round for the player.
+ */
+Outcome Table::playRound(Deck &deck, Player &player, int bet, const Strategy &strategy)
+{
+    Player *seat = &player;
+    Outcome outcome;
+    playRound(deck, &seat, &bet, 1, strategy, &outcome);
+    return outcome;
+}
+
+/**
+ * @brief Plays and settles one round for every seated player.
+ *
+ * @param deck The deck or shoe to deal from. It must hold enough cards for a round.
+ * @param seats The players, in seat order.
+ * @param bets The amount wagered by each seat.
+ * @param count Number of seats.
+ * @param strategy The playing decisions used for every player.
+ * @param outcomes Receives the result of each seat.
+ */
+void Table::playRound(Deck &deck, Player *const *seats, const int *bets, std::size_t count,
+                      const Strategy &strategy, Outcome *outcomes)
+{
+    AllocScope scope(AllocSite::Round);
+    dealer.resetForRound();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Player &player = *seats[i];
+        player.resetForRound();
+        player.setBet(bets[i]);
+        player.takeCard(deck.deal());
+        player.takeCard(deck.deal());
+    }
+    dealer.takeCard(deck.deal());
+    dealer.takeCard(deck.deal());
+
+    const Card &upcard = dealer.getHand()[1];
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Player &player = *seats[i];
+        while (!player.isBusted() && strategy.decide(player.getHand(), upcard) == Action::Hit)
+        {
+            player.takeCard(deck.deal());
+        }
+    }
+
+    while (dealer.handValue() < 17)
+    {
+        dealer.takeCard(deck.deal());
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Player &player = *seats[i];
+        outcomes[i] = judge(player.handValue(), dealer.handValue());
+        switch (outcomes[i])
+        {
+        case Outcome::Victory:
+            player.win();
+            break;
+        case Outcome::Tie:
+            player.tie();
+            break;
+        case Outcome::Defeat:
+            player.lose();
+            break;
+        }
+    }
+
+    // A continuous shuffling machine takes the used cards back right away
+    if (deck.isContinuous())
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            for (const Card &card : seats[i]->getHand())
+                deck.discard(card);
+        for (const Card &card : dealer.getHand())
+            deck.discard(card);
+    }
+}
+
+const Player &Table::getDealer() const
+{
+    return dealer;
+}
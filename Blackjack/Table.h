@@ -0,0 +1,37 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+#include "Deck.h"
+#include "Player.h"
+#include "Rules.h"
+#include "Strategy.h"
+
+/**
+ * @class Table
+ * @brief Headless version of the Game round loop, driven by a Strategy.
+ *
+ * A Table plays the same round as Game::playRound — deal two cards to each
+ * player and two to the dealer, let the players act in seat order, then let
+ * the dealer draw to 17 — and settles it the same way as Game::showResult, but
+ * without any console input or output. It is the engine used by simulations
+ * and automated tournaments.
+ *
+ * @note As in Game, the dealer's second card is the visible upcard. When the deck
+ *       is a continuous shuffling machine, the round's cards are discarded back
+ *       into it once the round is settled.
+ */
+class Table
+{
+public:
+    Table();
+
+    Outcome playRound(Deck &deck, Player &player, int bet, const Strategy &strategy);
+    void playRound(Deck &deck, Player *const *seats, const int *bets, std::size_t count,
+                   const Strategy &strategy, Outcome *outcomes);
+    const Player &getDealer() const;
+
+private:
+    Player dealer;
+};
+
+#endif
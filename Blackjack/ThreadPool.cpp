@@ -0,0 +1,95 @@
+#include "ThreadPool.h"
+
+/**
+ * @brief Starts the worker threads.
+ *
+ * @param threads Total number of threads running tasks, including the caller
+ *                of run(). Values below 1 are treated as 1.
+ */
+ThreadPool::ThreadPool(unsigned threads)
+{
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Number of threads that execute tasks, including the caller of run().
+ */
+unsigned ThreadPool::size() const
+{
+    return static_cast<unsigned>(workers.size()) + 1;
+}
+
+/**
+ * @brief Runs task(i) for every i in [0, count) and waits for all of them.
+ *
+ * @param count Number of tasks.
+ * @param task The work to perform for each index. Must be safe to call concurrently.
+ */
+void ThreadPool::run(std::size_t count, const std::function<void(std::size_t)> &task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        current = &task;
+        taskCount = count;
+        nextTask = 0;
+        busy = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]
+              { return busy == 0; });
+    current = nullptr;
+}
+
+/**
+ * @brief Executes tasks of the current batch until none are left.
+ */
+void ThreadPool::drain()
+{
+    for (std::size_t i = nextTask++; i < taskCount; i = nextTask++)
+    {
+        (*current)(i);
+    }
+}
+
+void ThreadPool::work()
+{
+    std::size_t seen = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]
+                      { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+        }
+
+        drain();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0)
+            done.notify_one();
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that run indexed batches of tasks.
+ *
+ * run() hands out task indices 0..count-1 to the workers and to the calling
+ * thread, and returns once every task has finished. Workers are created once
+ * and sleep between batches, so repeated batches pay no thread start-up cost.
+ */
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void run(std::size_t count, const std::function<void(std::size_t)> &task);
+    unsigned size() const;
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const std::function<void(std::size_t)> *current = nullptr;
+    std::size_t taskCount = 0;
+    std::atomic<std::size_t> nextTask{0};
+    std::size_t busy = 0;
+    std::size_t generation = 0;
+    bool stopping = false;
+
+    void work();
+    void drain();
+};
+
+#endif
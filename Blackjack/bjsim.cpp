@@ -0,0 +1,661 @@
+#include "Advisor.h"
+#include "AllocStats.h"
+#include "MultiTableTournament.h"
+#include "Optimizer.h"
+#include "ResultFile.h"
+#include "ShoeCorpus.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Command-line options of the form "--name value", plus positional arguments.
+     */
+    class Options
+    {
+    public:
+        Options(int argc, char **argv, int first)
+        {
+            for (int i = first; i < argc; ++i)
+            {
+                std::string arg = argv[i];
+                if (arg.rfind("--", 0) == 0 && i + 1 < argc)
+                    values[arg.substr(2)] = argv[++i];
+                else
+                    positional.push_back(arg);
+            }
+        }
+
+        const std::vector<std::string> &arguments() const
+        {
+            return positional;
+        }
+
+        std::string get(const std::string &name, const std::string &fallback) const
+        {
+            auto it = values.find(name);
+            return it == values.end() ? fallback : it->second;
+        }
+
+        /**
+         * @brief Reads an integer option that must lie in [@p min, @p max].
+         *
+         * A malformed or out-of-range value is recorded (see valid()) and the
+         * fallback is returned instead.
+         */
+        long long getInt(const std::string &name, long long fallback, long long min = 0,
+                         long long max = std::numeric_limits<long long>::max()) const
+        {
+            auto it = values.find(name);
+            if (it == values.end())
+                return fallback;
+            const std::string &text = it->second;
+            char *end = nullptr;
+            errno = 0;
+            long long value = std::strtoll(text.c_str(), &end, 10);
+            bool digitFirst = !text.empty() && (std::isdigit(static_cast<unsigned char>(text[0])) || text[0] == '-');
+            if (!digitFirst || *end != '\0' || errno == ERANGE || value < min || value > max)
+            {
+                reject(name, text, std::to_string(min), std::to_string(max));
+                return fallback;
+            }
+            return value;
+        }
+
+        /**
+         * @brief Reads a finite real option that must lie in [@p min, @p max].
+         */
+        double getDouble(const std::string &name, double fallback, double min, double max) const
+        {
+            auto it = values.find(name);
+            if (it == values.end())
+                return fallback;
+            const std::string &text = it->second;
+            char *end = nullptr;
+            double value = std::strtod(text.c_str(), &end);
+            bool digitFirst = !text.empty() && (std::isdigit(static_cast<unsigned char>(text[0])) || text[0] == '.');
+            if (!digitFirst || *end != '\0' || !std::isfinite(value) || value < min || value > max)
+            {
+                std::ostringstream lo, hi;
+                lo << min;
+                hi << max;
+                reject(name, text, lo.str(), hi.str());
+                return fallback;
+            }
+            return value;
+        }
+
+        /** @brief false once any numeric option failed to parse or was out of range. */
+        bool valid() const
+        {
+            return problem.empty();
+        }
+
+        /** @brief Describes the first invalid option. */
+        const std::string &error() const
+        {
+            return problem;
+        }
+
+    private:
+        void reject(const std::string &name, const std::string &text, const std::string &min,
+                    const std::string &max) const
+        {
+            if (problem.empty())
+                problem = "Invalid --" + name + " " + text + " (expected a number from " + min + " to " + max + ")";
+        }
+
+        std::map<std::string, std::string> values;
+        std::vector<std::string> positional;
+        mutable std::string problem;
+    };
+
+    void usage()
+    {
+        std::cerr << "Usage: bjsim <command> [--option value ...]\n"
+                  << "Commands:\n"
+                  << "  optimize   Search strategy and bet-ramp tables on common shoes\n"
+                  << "             --shoes N --decks D --penetration P --iterations I\n"
+                  << "             --max-bet U --seed S --threads T\n"
+                  << "             --corpus FILE  (use the shoes of a corpus instead)\n"
+                  << "  simulate   Estimate the house edge of basic strategy\n"
+                  << "             --mode none|antithetic|stratified|control --ci-width W\n"
+                  << "             --max-rounds N --decks D --seed S --threads T\n"
+                  << "             --shard I/K --out FILE  (play shard I of K, write the result)\n"
+                  << "             --report 1  (print outcome statistics per decision)\n"
+                  << "  merge      Merge result files: --out FILE shard0 shard1 ...\n"
+                  << "  corpus     Write a corpus of pre-shuffled shoes\n"
+                  << "             --shoes N --decks D --seed S --out FILE\n"
+                  << "  tournament Automated multi-table tournament played in parallel\n"
+                  << "             --entrants N --rounds R --bet B --decks D --seed S --threads T\n"
+                  << "  alloc-check Fail if a steady-state headless round allocates more than a budget\n"
+                  << "             --budget N --rounds R --warmup W --seats S --decks D\n"
+                  << "             --csm 1  (deal from a continuous shuffling machine)\n"
+                  << "             (needs a build made with ALLOC_STATS=1)\n"
+                  << "  advisor-check Check advisor latency and that cached advice matches a cold analysis\n"
+                  << "             --rounds N --decks D --seed S --budget-us U\n"
+                  << "  shuffle-check Chi-square test that lazy and eager dealing are uniform\n"
+                  << "             --trials N --decks D --seed S\n";
+    }
+
+    /** Largest shoe any command accepts; the corpus header stores it in 16 bits. */
+    const long long MaxDecks = 1024;
+    const long long MaxInt = std::numeric_limits<int>::max();
+
+    /**
+     * @brief Reports the first invalid numeric option.
+     *
+     * @return int Always 1, the exit code of a usage error.
+     */
+    int invalidOptions(const Options &options)
+    {
+        std::cerr << options.error() << "\n";
+        usage();
+        return 1;
+    }
+
+    unsigned threadCount(const Options &options)
+    {
+        return static_cast<unsigned>(options.getInt("threads", std::thread::hardware_concurrency(), 1, 1024));
+    }
+
+    int optimize(const Options &options)
+    {
+        unsigned threads = threadCount(options);
+        std::size_t shoeCount = static_cast<std::size_t>(options.getInt("shoes", 2000, 1));
+        int numDecks = static_cast<int>(options.getInt("decks", 6, 1, MaxDecks));
+        std::uint64_t seed = static_cast<std::uint64_t>(options.getInt("seed", 1));
+        double penetration = options.getDouble("penetration", 0.75, 0.1, 1.0);
+        int maxBet = static_cast<int>(options.getInt("max-bet", 8, 1, MaxInt));
+        std::size_t iterations = static_cast<std::size_t>(options.getInt("iterations", 200));
+        if (!options.valid())
+            return invalidOptions(options);
+
+        ThreadPool pool(threads);
+        std::unique_ptr<ShoeSource> shoes;
+        std::string corpusPath = options.get("corpus", "");
+        if (corpusPath.empty())
+        {
+            shoes = std::make_unique<ShoeSet>(shoeCount, numDecks, seed);
+        }
+        else
+        {
+            auto corpus = std::make_unique<ShoeCorpus>(corpusPath);
+            if (!corpus->isOpen())
+            {
+                std::cerr << "Cannot open corpus " << corpusPath << " (missing or corrupt)\n";
+                return 1;
+            }
+            shoes = std::move(corpus);
+        }
+        Optimizer optimizer(*shoes, penetration, maxBet, pool);
+
+        Strategy best = optimizer.optimize(Strategy::basic(), iterations, seed + 1, std::cout);
+        std::cout << "\nBest strategy:\n";
+        best.print(std::cout);
+        return 0;
+    }
+
+    SimulationConfig simulationConfig(const Options &options)
+    {
+        SimulationConfig config;
+        config.numDecks = static_cast<int>(options.getInt("decks", config.numDecks, 1, MaxDecks));
+        config.seed = static_cast<std::uint64_t>(options.getInt("seed", static_cast<long long>(config.seed)));
+        config.ciWidth = options.getDouble("ci-width", config.ciWidth, 0.0, 1.0);
+        // Bounded so maxRounds + blockRounds cannot overflow; blocks hold antithetic pairs
+        config.maxRounds = options.getInt("max-rounds", config.maxRounds, 1, 1LL << 50);
+        config.blockRounds = options.getInt("block-rounds", config.blockRounds, 2, 1LL << 30);
+        if (!parseVarianceReduction(options.get("mode", "none"), config.mode))
+            std::cerr << "Unknown mode, using none.\n";
+        return config;
+    }
+
+    void printEstimate(const Estimate &e, VarianceReduction mode)
+    {
+        std::cout << "House edge (" << varianceReductionName(mode) << "): "
+                  << e.houseEdge * 100 << "% ± " << e.standardError * 100 << "% (1 s.e.)\n";
+    }
+
+    /**
+     * @brief Parses "I/K" (or "I", meaning I/1) into shard I of K.
+     *
+     * @return false unless both are plain non-negative integers with I < K.
+     */
+    bool parseShard(const std::string &text, std::uint64_t &index, std::uint64_t &shards)
+    {
+        auto number = [](const std::string &digits, std::uint64_t &value)
+        {
+            if (digits.empty() || digits.size() > 18 ||
+                !std::all_of(digits.begin(), digits.end(), [](char c)
+                             { return c >= '0' && c <= '9'; }))
+                return false;
+            value = std::stoull(digits);
+            return true;
+        };
+        std::size_t slash = text.find('/');
+        shards = 1;
+        if (!number(text.substr(0, slash), index))
+            return false;
+        if (slash != std::string::npos && !number(text.substr(slash + 1), shards))
+            return false;
+        return shards > 0 && index < shards;
+    }
+
+    int simulate(const Options &options)
+    {
+        unsigned threads = threadCount(options);
+        SimulationConfig config = simulationConfig(options);
+        bool report = options.getInt("report", 0, 0, 1) != 0;
+        if (!options.valid())
+            return invalidOptions(options);
+
+        ThreadPool pool(threads);
+        Strategy strategy = Strategy::basic();
+        Simulation simulation(config, strategy, pool);
+
+        const SimulationConfig &used = simulation.getConfig();
+        OutcomeStats stats;
+        ResultFile file;
+        file.numDecks = used.numDecks;
+        file.mode = used.mode;
+        file.seed = used.seed;
+        file.blockRounds = used.blockRounds;
+
+        std::string shard = options.get("shard", "");
+        if (!shard.empty())
+        {
+            // Shards split the blocks of a fixed-size run; the stopping rule does not apply.
+            std::uint64_t index, shards;
+            if (!parseShard(shard, index, shards))
+            {
+                std::cerr << "Invalid shard " << shard << " (expected I/K with 0 <= I < K)\n";
+                usage();
+                return 1;
+            }
+            file.totalBlocks = static_cast<std::uint64_t>((used.maxRounds + used.blockRounds - 1) / used.blockRounds);
+            std::uint64_t first = file.totalBlocks * index / shards;
+            std::uint64_t last = file.totalBlocks * (index + 1) / shards;
+            if (last > first)
+                file.ranges.push_back({first, last - first});
+            file.result = simulation.runBlocks(first, last - first, report ? &stats : nullptr);
+        }
+        else
+        {
+            file.result = simulation.run(std::cout, report ? &stats : nullptr);
+            // An adaptive run is its own complete run of however many blocks it needed
+            file.totalBlocks = static_cast<std::uint64_t>(file.result.rounds / used.blockRounds);
+            if (file.totalBlocks > 0)
+                file.ranges.push_back({0, file.totalBlocks});
+        }
+
+        printEstimate(simulation.estimate(file.result), config.mode);
+        std::cout << "Rounds: " << file.result.rounds
+                  << " | Dealer busts: " << 100.0 * file.result.dealerBusts / file.result.rounds << "%\n";
+        if (report)
+            stats.report(std::cout);
+
+        std::string out = options.get("out", "");
+        if (!out.empty() && !writeResultFile(out, file))
+        {
+            std::cerr << "Cannot write " << out << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    int corpus(const Options &options)
+    {
+        std::string out = options.get("out", "");
+        if (out.empty())
+        {
+            usage();
+            return 1;
+        }
+        std::size_t shoeCount = static_cast<std::size_t>(options.getInt("shoes", 10000, 1));
+        int numDecks = static_cast<int>(options.getInt("decks", 6, 1, MaxDecks));
+        std::uint64_t seed = static_cast<std::uint64_t>(options.getInt("seed", 1));
+        if (!options.valid())
+            return invalidOptions(options);
+
+        ShoeSet shoes(shoeCount, numDecks, seed);
+        if (!ShoeCorpus::write(out, shoes))
+        {
+            std::cerr << "Cannot write " << out << "\n";
+            return 1;
+        }
+        std::cout << "Wrote " << shoes.size() << " shoes of " << shoes.getNumDecks() << " deck(s) to " << out << "\n";
+        return 0;
+    }
+
+    int tournament(const Options &options)
+    {
+        unsigned threads = threadCount(options);
+        TournamentConfig config;
+        config.entrants = static_cast<std::size_t>(options.getInt("entrants", static_cast<long long>(config.entrants), 1));
+        config.rounds = static_cast<int>(options.getInt("rounds", config.rounds, 1, MaxInt));
+        config.bet = static_cast<int>(options.getInt("bet", config.bet, 1, MaxInt));
+        config.numDecks = static_cast<int>(options.getInt("decks", config.numDecks, 1, MaxDecks));
+        config.seed = static_cast<std::uint64_t>(options.getInt("seed", static_cast<long long>(config.seed)));
+        if (!options.valid())
+            return invalidOptions(options);
+
+        ThreadPool pool(threads);
+        Strategy strategy = Strategy::basic();
+        MultiTableTournament tournament(config, strategy, pool);
+        tournament.run(std::cout);
+        return 0;
+    }
+
+    /**
+     * @brief Plays headless rounds and checks each one against an allocation budget.
+     *
+     * The first rounds are not checked, so one-off growth (vector capacity, lazily built
+     * tables) does not count. Every later round is measured on its own, like Game does:
+     * deck reset (or, with a shuffling machine, reinsertion of the used cards), dealing,
+     * decisions and settlement.
+     */
+    int allocCheck(const Options &options)
+    {
+        if (!allocstats::enabled())
+        {
+            std::cerr << "alloc-check needs an instrumented build: make clean && make ALLOC_STATS=1\n";
+            return 1;
+        }
+
+        std::uint64_t budget = static_cast<std::uint64_t>(options.getInt("budget", 0));
+        long long rounds = options.getInt("rounds", 1000, 1);
+        long long warmup = options.getInt("warmup", 10);
+        std::size_t seatCount = static_cast<std::size_t>(
+            options.getInt("seats", 1, 1, static_cast<long long>(MultiTableTournament::MaxSeats)));
+        int numDecks = static_cast<int>(options.getInt("decks", 1, 1, MaxDecks));
+        bool continuous = options.getInt("csm", 0, 0, 1) != 0;
+        if (!options.valid())
+            return invalidOptions(options);
+
+        Deck deck(numDecks);
+        deck.setLazyShuffle(true);
+        if (continuous)
+            deck.setContinuous(true);
+        Strategy strategy = Strategy::basic();
+        Table table;
+        std::vector<Player> players;
+        for (std::size_t i = 0; i < seatCount; ++i)
+            players.emplace_back("Seat " + std::to_string(i + 1));
+        std::vector<Player *> seats;
+        for (Player &player : players)
+            seats.push_back(&player);
+        std::vector<int> bets(seatCount, 1);
+        std::vector<Outcome> outcomes(seatCount);
+
+        AllocCounters worst;
+        AllocCounters total;
+        long long worstRound = 0;
+        for (long long round = 0; round < warmup + rounds; ++round)
+        {
+            AllocCounters start = allocstats::snapshot();
+            if (!continuous)
+                deck.reset();
+            table.playRound(deck, seats.data(), bets.data(), seatCount, strategy, outcomes.data());
+            AllocCounters used = allocstats::snapshot() - start;
+            if (round < warmup)
+                continue;
+
+            total += used;
+            if (round == warmup || used.totalAllocations() > worst.totalAllocations())
+            {
+                worst = used;
+                worstRound = round - warmup + 1;
+            }
+        }
+
+        std::cout << "Checked " << rounds << " rounds after " << warmup << " warm-up rounds\n";
+        std::cout << "Total ";
+        allocstats::report(std::cout, total);
+        std::cout << "Worst (round " << worstRound << ") ";
+        allocstats::report(std::cout, worst);
+        if (worst.totalAllocations() > budget)
+        {
+            std::cout << "FAIL: " << worst.totalAllocations() << " allocations in one round, budget " << budget << "\n";
+            return 1;
+        }
+        std::cout << "OK: within the budget of " << budget << " allocations per round\n";
+        return 0;
+    }
+
+    /**
+     * @brief Deals whole shoes and checks every card is equally likely at every position.
+     *
+     * Runs once with an up-front shuffle and once with the lazy per-deal shuffle, counting
+     * each of the 52 distinct cards at each deal position. A uniform shuffle puts every
+     * cell at trials * decks / cards, and the chi-square statistic then has
+     * 51 * (cards - 1) degrees of freedom. A mode fails when the statistic lies more than
+     * 4 standard deviations above that mean (a false alarm about once in 30,000 runs).
+     */
+    int shuffleCheck(const Options &options)
+    {
+        long long trials = options.getInt("trials", 20000, 260);
+        int numDecks = static_cast<int>(options.getInt("decks", 1, 1, MaxDecks));
+        std::uint32_t seed = static_cast<std::uint32_t>(options.getInt("seed", 1));
+        if (!options.valid())
+            return invalidOptions(options);
+
+        std::size_t cards = static_cast<std::size_t>(52) * numDecks;
+        double expected = static_cast<double>(trials) * numDecks / static_cast<double>(cards);
+        double freedom = 51.0 * static_cast<double>(cards - 1);
+        double limit = freedom + 4.0 * std::sqrt(2.0 * freedom);
+        bool uniform = true;
+        for (bool lazy : {false, true})
+        {
+            Deck deck(numDecks);
+            deck.seed(seed);
+            deck.setLazyShuffle(lazy);
+            std::vector<std::uint64_t> counts(52 * cards, 0);
+            for (long long trial = 0; trial < trials; ++trial)
+            {
+                deck.reset();
+                for (std::size_t position = 0; position < cards; ++position)
+                {
+                    Card card = deck.deal();
+                    std::size_t index = static_cast<std::size_t>(card.getRank() - 1) +
+                                        13 * static_cast<std::size_t>(card.getSuit());
+                    ++counts[index * cards + position];
+                }
+            }
+
+            double statistic = 0.0;
+            for (std::uint64_t observed : counts)
+            {
+                double diff = static_cast<double>(observed) - expected;
+                statistic += diff * diff / expected;
+            }
+            bool ok = statistic <= limit;
+            uniform = uniform && ok;
+            std::cout << (lazy ? "lazy " : "eager") << "  chi-square " << statistic << " (df " << freedom
+                      << ", limit " << limit << ") " << (ok ? "OK" : "FAIL") << "\n";
+        }
+        return uniform ? 0 : 1;
+    }
+
+    /**
+     * @brief Plays rounds following the advisor and checks every decision.
+     *
+     * A long-lived advisor (warm cache, as in Game) answers each decision under the
+     * deadline; a fresh advisor given the same cards recomputes it from scratch with
+     * no deadline. The two must agree exactly, and the warm advisor's 99th percentile
+     * latency must stay within the budget.
+     */
+    int advisorCheck(const Options &options)
+    {
+        long long rounds = options.getInt("rounds", 2000, 1);
+        // The advisor packs each value's removed count in 4 bits
+        int numDecks = static_cast<int>(options.getInt("decks", 1, 1, 15));
+        std::chrono::microseconds budget(options.getInt("budget-us", 1000, 1));
+        std::uint32_t seed = static_cast<std::uint32_t>(options.getInt("seed", 1));
+        if (!options.valid())
+            return invalidOptions(options);
+
+        Deck deck(numDecks);
+        deck.seed(seed);
+        deck.setLazyShuffle(true);
+        Advisor warm(numDecks, budget);
+        std::vector<Card> seen;
+        std::vector<double> latencies;
+        long long mismatches = 0;
+        long long fallbacks = 0;
+        double coldTotal = 0.0;
+
+        for (long long round = 0; round < rounds; ++round)
+        {
+            deck.reset();
+            warm.reset();
+            seen.clear();
+            Hand hand;
+            hand.add(deck.deal());
+            hand.add(deck.deal());
+            deck.deal(); // hole card, never observed
+            Card upcard = deck.deal();
+            for (const Card &card : {hand[0], hand[1], upcard})
+            {
+                warm.observe(card);
+                seen.push_back(card);
+            }
+
+            while (hand.value() <= 21)
+            {
+                auto start = std::chrono::steady_clock::now();
+                Advice advice = warm.advise(hand, upcard);
+                auto middle = std::chrono::steady_clock::now();
+
+                Advisor cold(numDecks, std::chrono::seconds(10));
+                for (const Card &card : seen)
+                    cold.observe(card);
+                Advice reference = cold.advise(hand, upcard);
+                auto end = std::chrono::steady_clock::now();
+
+                latencies.push_back(std::chrono::duration<double, std::micro>(middle - start).count());
+                coldTotal += std::chrono::duration<double, std::micro>(end - middle).count();
+                if (!advice.exact)
+                    ++fallbacks;
+                else if (advice.action != reference.action || advice.hitEv != reference.hitEv ||
+                         advice.standEv != reference.standEv)
+                    ++mismatches;
+
+                if (advice.action != Action::Hit)
+                    break;
+                Card card = deck.deal();
+                hand.add(card);
+                warm.observe(card);
+                seen.push_back(card);
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        double mean = 0.0;
+        for (double latency : latencies)
+            mean += latency;
+        mean /= static_cast<double>(latencies.size());
+        double p99 = latencies[latencies.size() * 99 / 100];
+
+        std::cout << "Decisions: " << latencies.size() << " | fallbacks: " << fallbacks
+                  << " | mismatches: " << mismatches << "\n";
+        std::cout << "Latency (us): mean " << mean << " | p99 " << p99 << " | max " << latencies.back()
+                  << " | cold mean " << coldTotal / static_cast<double>(latencies.size()) << "\n";
+        if (mismatches > 0 || p99 > static_cast<double>(budget.count()))
+        {
+            std::cout << "FAIL\n";
+            return 1;
+        }
+        std::cout << "OK\n";
+        return 0;
+    }
+
+    int merge(const Options &options)
+    {
+        ResultFile merged;
+        for (const std::string &path : options.arguments())
+        {
+            ResultFile shard;
+            if (!readResultFile(path, shard))
+            {
+                std::cerr << "Cannot read result file " << path << "\n";
+                return 1;
+            }
+            if (!mergeResultFile(merged, shard))
+            {
+                std::cerr << path << " comes from a different run or overlaps blocks already merged\n";
+                return 1;
+            }
+        }
+        if (merged.result.rounds == 0)
+        {
+            std::cerr << "Nothing to merge.\n";
+            return 1;
+        }
+
+        printEstimate(estimate(merged.result, merged.mode, merged.numDecks), merged.mode);
+        std::cout << "Rounds: " << merged.result.rounds << " in " << merged.blockCount() << " of "
+                  << merged.totalBlocks << " blocks\n";
+        if (!merged.isComplete())
+            std::cout << "Note: some shards are missing; this is not yet the full run.\n";
+
+        std::string out = options.get("out", "");
+        if (!out.empty() && !writeResultFile(out, merged))
+        {
+            std::cerr << "Cannot write " << out << "\n";
+            return 1;
+        }
+        return 0;
+    }
+}
+
+/**
+ * @brief Entry point of the headless Blackjack simulator.
+ *
+ * Runs batch jobs (strategy optimization, simulations...) on the same round
+ * logic as the interactive game, without any console interaction.
+ *
+ * @return int 0 on success, 1 on a usage error.
+ */
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        usage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    Options options(argc, argv, 2);
+    if (command == "optimize")
+        return optimize(options);
+    if (command == "simulate")
+        return simulate(options);
+    if (command == "merge")
+        return merge(options);
+    if (command == "corpus")
+        return corpus(options);
+    if (command == "tournament")
+        return tournament(options);
+    if (command == "alloc-check")
+        return allocCheck(options);
+    if (command == "advisor-check")
+        return advisorCheck(options);
+    if (command == "shuffle-check")
+        return shuffleCheck(options);
+
+    usage();
+    return 1;
+}
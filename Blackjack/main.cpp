@@ -1,5 +1,33 @@
 #include "Game.h"
+#include <algorithm>
 #include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+    void usage()
+    {
+        std::cerr << "Usage: blackjack [options]\n"
+                  << "  --script FILE   Read every answer from an action script\n"
+                  << "  --quiet         Discard all rendering\n"
+                  << "  --shoe-queue N  Shuffle up to N decks ahead on a background thread (1-1024)\n"
+                  << "  --advisor       Show the best action and its expected value\n"
+                  << "  --csm           Deal from a continuous shuffling machine\n";
+    }
+
+    /**
+     * @brief Parses a shoe queue depth: a plain decimal number from 1 to 1024.
+     */
+    bool parseDepth(const std::string &text, std::size_t &depth)
+    {
+        if (text.empty() || text.size() > 4 || !std::all_of(text.begin(), text.end(), [](char c)
+                                                            { return c >= '0' && c <= '9'; }))
+            return false;
+        depth = std::stoul(text);
+        return depth >= 1 && depth <= 1024;
+    }
+}
 
 /**
  * @brief Entry point of the Blackjack application.
@@ -14,21 +42,102 @@
  * User input is handled via standard input, and appropriate
  * methods of the Game class are called based on the user's choice.
  *
- * @return int Returns 0 upon successful execution.
+ * Command-line options:
+ *   --script FILE  Read every answer from an action script instead of the keyboard.
+ *   --quiet        Discard all rendering (useful with --script for load tests).
+ *   --shoe-queue N Shuffle up to N decks ahead of time on a background thread.
+ *   --advisor      Show the best action and its expected value before each decision.
+ *   --csm          Deal from a continuous shuffling machine (used cards go back after each round).
+ *                  Cannot be combined with --shoe-queue.
+ *
+ * @return int Returns 0 upon successful execution, 1 on an invalid option or if the script cannot be opened.
  */
-int main()
+int main(int argc, char **argv)
 {
-    Game game;
+    std::ios::sync_with_stdio(false);
+
+    std::string scriptPath;
+    bool quiet = false;
+    std::size_t shoeQueueDepth = 0;
+    bool advise = false;
+    bool continuous = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--script" && i + 1 < argc)
+        {
+            scriptPath = argv[++i];
+        }
+        else if (arg == "--quiet")
+        {
+            quiet = true;
+        }
+        else if (arg == "--shoe-queue" && i + 1 < argc)
+        {
+            if (!parseDepth(argv[++i], shoeQueueDepth))
+            {
+                std::cerr << "Invalid shoe queue depth " << argv[i] << "\n";
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--advisor")
+        {
+            advise = true;
+        }
+        else if (arg == "--csm")
+        {
+            continuous = true;
+        }
+        else
+        {
+            std::cerr << "Unknown option or missing value: " << arg << "\n";
+            usage();
+            return 1;
+        }
+    }
+
+    if (continuous && shoeQueueDepth > 0)
+    {
+        std::cerr << "--csm and --shoe-queue cannot be combined: a shuffling machine never needs a fresh deck\n";
+        usage();
+        return 1;
+    }
+
+    std::unique_ptr<Input> input;
+    if (scriptPath.empty())
+    {
+        input = std::make_unique<ConsoleInput>();
+    }
+    else
+    {
+        auto script = std::make_unique<ScriptInput>(scriptPath);
+        if (!script->isOpen())
+        {
+            std::cerr << "Cannot open script " << scriptPath << "\n";
+            return 1;
+        }
+        input = std::move(script);
+    }
+
+    // A stream without a buffer is permanently failed, so writes to it are no-ops
+    std::ostream nullSink(nullptr);
+    std::ostream &out = quiet ? nullSink : std::cout;
+
+    Game game(*input, out, shoeQueueDepth);
+    game.setAdvisor(advise);
+    game.setContinuousShuffle(continuous);
     int choice;
     do
     {
-        std::cout << "\n===== MENU =====\n";
-        std::cout << "1. New single game\n";
-        std::cout << "2. Tournament mode (rounds + ranking)\n";
-        std::cout << "3. View score history\n";
-        std::cout << "4. Quit\n";
-        std::cout << "Your choice: ";
-        std::cin >> choice;
+        out << "\n===== MENU =====\n";
+        out << "1. New single game\n";
+        out << "2. Tournament mode (rounds + ranking)\n";
+        out << "3. View score history\n";
+        out << "4. Quit\n";
+        out << "Your choice: ";
+        if (!input->readInt(choice))
+            choice = 4;
 
         switch (choice)
         {
@@ -42,10 +151,10 @@ int main()
             game.displayScores();
             break;
         case 4:
-            std::cout << "See you soon!\n";
+            out << "See you soon!\n";
             break;
         default:
-            std::cout << "Invalid choice.\n";
+            out << "Invalid choice.\n";
         }
     } while (choice != 4);
 